@@ -0,0 +1,264 @@
+"""Microbenchmark: the overhead of NewType descriptors, per base type.
+
+For every base type this times five operations on a plain value and on an instance
+of a trivial NewType over it:
+    - construct: build an instance from a base-type value
+    - passthrough: a wrapped method returning something other than the base type
+    - rewrap: a wrapped method returning the base type, rewrapped into the NewType
+    - operator: a wrapped dunder method reached through an operator
+    - isinstance: `isinstance` against the class of the value
+
+Each timing is the best per-call time over several repeats of `timeit`, and the
+ratio is NewType over plain. Results are written as JSON. Given a baseline file
+from an earlier run, the ratios are compared, and the script exits with status 1
+if one grew by more than the tolerance. Comparing ratios, rather than times, keeps
+results from different machines comparable.
+
+Base types whose module cannot be imported, such as `pandas.DataFrame`, are
+skipped.
+
+Usage:
+    python benchmarks/descriptor_overhead.py [--output FILE] [--baseline FILE]
+        [--tolerance 0.25] [--repeat 5] [--only str,int]
+"""
+
+import argparse
+import json
+import platform
+import sys
+import time
+import timeit
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Optional
+
+import newtype
+from newtype import NewType
+
+
+OPERATIONS = ("construct", "passthrough", "rewrap", "operator", "isinstance")
+
+
+class Point:
+    def __init__(self, x: int, y: int) -> None:
+        self.x = x
+        self.y = y
+
+    def norm(self) -> int:
+        return abs(self.x) + abs(self.y)
+
+    def moved(self, dx: int) -> "Point":
+        return Point(self.x + dx, self.y)
+
+    def __add__(self, other: "Point") -> "Point":
+        return Point(self.x + other.x, self.y + other.y)
+
+
+class SlotPoint:
+    __slots__ = ("x", "y")
+
+    def __init__(self, x: int, y: int) -> None:
+        self.x = x
+        self.y = y
+
+    def norm(self) -> int:
+        return abs(self.x) + abs(self.y)
+
+    def moved(self, dx: int) -> "SlotPoint":
+        return SlotPoint(self.x + dx, self.y)
+
+    def __add__(self, other: "SlotPoint") -> "SlotPoint":
+        return SlotPoint(self.x + other.x, self.y + other.y)
+
+
+# Each case gives the base type, a value of it, and one statement per operation;
+# `x` is the value under test and `cls` its class. Containers fill themselves in
+# `__init__`, which a NewType must then call, as `fill` says.
+CASES: "Dict[str, Callable[[], Dict[str, Any]]]" = {
+    "str": lambda: {
+        "base": str,
+        "value": "hello world",
+        "construct": "cls(v)",
+        "passthrough": "x.startswith('he')",
+        "rewrap": "x.upper()",
+        "operator": "x + '!'",
+    },
+    "int": lambda: {
+        "base": int,
+        "value": 12345,
+        "construct": "cls(v)",
+        "passthrough": "x.to_bytes(4, 'little')",
+        "rewrap": "x.conjugate()",
+        "operator": "x + 1",
+    },
+    "float": lambda: {
+        "base": float,
+        "value": 3.25,
+        "construct": "cls(v)",
+        "passthrough": "x.is_integer()",
+        "rewrap": "x.conjugate()",
+        "operator": "x * 2.0",
+    },
+    "list": lambda: {
+        "base": list,
+        "fill": True,
+        "value": [1, 2, 3, 4],
+        "construct": "cls(v)",
+        "passthrough": "x.index(3)",
+        "rewrap": "x.copy()",
+        "operator": "x + [5]",
+    },
+    # rewraps of a large list, whose contents dominate the cost of a copy
+    "list_100k": lambda: {
+        "base": list,
+        "fill": True,
+        "value": list(range(100_000)),
+        "construct": "cls(v)",
+        "passthrough": "x.index(3)",
+        "rewrap": "x.copy()",
+        "operator": "x + [5]",
+    },
+    "dict": lambda: {
+        "base": dict,
+        "fill": True,
+        "value": {"a": 1, "b": 2},
+        "construct": "cls(v)",
+        "passthrough": "x.get('a')",
+        "rewrap": "x.copy()",
+        "operator": "x['b']",
+    },
+    "object": lambda: {
+        "base": Point,
+        "value": Point(1, 2),
+        "construct": "cls(v) if cls is not base else base(1, 2)",
+        "passthrough": "x.norm()",
+        "rewrap": "x.moved(1)",
+        "operator": "x + v",
+    },
+    "slots": lambda: {
+        "base": SlotPoint,
+        "value": SlotPoint(1, 2),
+        "construct": "cls(v) if cls is not base else base(1, 2)",
+        "passthrough": "x.norm()",
+        "rewrap": "x.moved(1)",
+        "operator": "x + v",
+    },
+    "DataFrame": lambda: dataframe_case(),
+}
+
+
+def dataframe_case() -> "Dict[str, Any]":
+    import pandas as pd  # noqa: PLC0415
+
+    return {
+        "base": pd.DataFrame,
+        "value": pd.DataFrame({"a": [1, 2, 3], "b": [4.0, 5.0, 6.0]}),
+        "construct": "cls(v)",
+        "passthrough": "x.to_numpy()",
+        # methods that end in `__finalize__`, such as `copy()`, fail on a rewrapped
+        # frame, whose `flags` refer to the frame it was built from
+        "rewrap": "x.transpose()",
+        "operator": "x + 1",
+    }
+
+
+def best_time(stmt: str, namespace: "Dict[str, Any]", repeat: int) -> float:
+    """Return the best time of one execution of `stmt`, in nanoseconds."""
+    timer = timeit.Timer(stmt, globals=namespace)
+    number, _ = timer.autorange()
+    return min(timer.repeat(repeat, number)) / number * 1e9
+
+
+def run_case(case: "Dict[str, Any]", repeat: int) -> "Dict[str, Dict[str, float]]":
+    base = case["base"]
+    newtype_cls = NewType(base)  # the methods of the base type, wrapped
+
+    class Wrapped(newtype_cls):  # type: ignore[misc, valid-type]
+        if case.get("fill"):
+
+            def __init__(self, value: Any) -> None:
+                base.__init__(self, value)
+
+    results: Dict[str, Dict[str, float]] = {}
+    for op in OPERATIONS:
+        times = {}
+        for label, cls in (("plain", base), ("newtype", Wrapped)):
+            value = case["value"]
+            x = value if cls is base else Wrapped(value)
+            namespace = {"cls": cls, "base": base, "v": value, "x": x}
+            stmt = "isinstance(x, cls)" if op == "isinstance" else case[op]
+            times[label] = best_time(stmt, namespace, repeat)
+        results[op] = {
+            "plain_ns": round(times["plain"], 2),
+            "newtype_ns": round(times["newtype"], 2),
+            "ratio": round(times["newtype"] / times["plain"], 3),
+        }
+    return results
+
+
+def metadata() -> "Dict[str, Any]":
+    return {
+        "python": platform.python_version(),
+        "implementation": platform.python_implementation(),
+        "platform": platform.platform(),
+        "newtype": newtype.__version__,
+        "timestamp": time.strftime("%Y-%m-%dT%H:%M:%S%z"),
+    }
+
+
+def compare(results: "Dict[str, Any]", baseline: "Dict[str, Any]", tolerance: float) -> "List[str]":
+    """Return a line for every ratio that grew by more than `tolerance`."""
+    regressions = []
+    for name, ops in results.items():
+        for op, timing in ops.items():
+            old = baseline.get(name, {}).get(op)
+            if old is None:
+                continue
+            growth = timing["ratio"] / old["ratio"] - 1
+            if growth > tolerance:
+                regressions.append(
+                    f"{name}.{op}: ratio {old['ratio']:.2f} -> {timing['ratio']:.2f}"
+                    f" (+{growth:.0%})"
+                )
+    return regressions
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--output", type=Path, help="write the results to this JSON file")
+    parser.add_argument("--baseline", type=Path, help="JSON results of an earlier run")
+    parser.add_argument("--tolerance", type=float, default=0.25)
+    parser.add_argument("--repeat", type=int, default=5)
+    parser.add_argument("--only", help="comma-separated base types to run")
+    args = parser.parse_args()
+
+    names = args.only.split(",") if args.only else list(CASES)
+    results: Dict[str, Any] = {}
+    print(f"{'base type':<12}{'operation':<14}{'plain ns':>10}{'newtype ns':>12}{'ratio':>8}")
+    for name in names:
+        try:
+            case = CASES[name]()
+        except ImportError as e:
+            print(f"{name:<12}skipped: {e}")
+            continue
+        results[name] = run_case(case, args.repeat)
+        for op, timing in results[name].items():
+            print(
+                f"{name:<12}{op:<14}{timing['plain_ns']:>10.1f}"
+                f"{timing['newtype_ns']:>12.1f}{timing['ratio']:>8.2f}"
+            )
+
+    if args.output:
+        args.output.parent.mkdir(parents=True, exist_ok=True)
+        args.output.write_text(json.dumps({"meta": metadata(), "results": results}, indent=2))
+
+    regressions: List[str] = []
+    if args.baseline:
+        baseline: Optional[Dict[str, Any]] = json.loads(args.baseline.read_text())
+        regressions = compare(results, (baseline or {}).get("results", {}), args.tolerance)
+        for line in regressions:
+            print(f"REGRESSION {line}")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
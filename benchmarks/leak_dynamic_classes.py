@@ -0,0 +1,77 @@
+"""Leak regression benchmark: NewType classes created and discarded at run time.
+
+Workers that build NewTypes on the fly, as `BoundedInt[n]` does through
+`__class_getitem__` in `examples/bounded_wrapped_ints.py`, leak unless every class
+can be freed once it is no longer used. A class and its `__init__` descriptor refer
+to each other, so only the garbage collector can free them.
+
+This creates and discards `--count` such classes, using each once. It exits with
+status 1 if the resident set size grows by more than `--limit-mb` after a warm-up,
+or if the classes are not freed.
+
+Usage:
+    python benchmarks/leak_dynamic_classes.py [--count N] [--limit-mb MB]
+"""
+
+import argparse
+import gc
+import os
+import resource
+import sys
+import weakref
+from pathlib import Path
+from typing import List
+
+from newtype import NewType
+
+
+def rss_mb() -> float:
+    """Return the current resident set size, or the peak where it is unavailable."""
+    try:
+        with Path("/proc/self/statm").open() as f:
+            pages = int(f.read().split()[1])
+        return pages * os.sysconf("SC_PAGE_SIZE") / 2**20
+    except (OSError, ValueError):
+        peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+        return peak / 2**20 if sys.platform == "darwin" else peak / 2**10
+
+
+def churn(count: int, bound: int = 1) -> "List[weakref.ref[type]]":
+    """Create and use `count` NewType classes, keeping weak references to them."""
+    refs = []
+    for i in range(count):
+
+        class BoundedInt(NewType(int)):  # type: ignore[misc]
+            MAX_VALUE = i + bound
+
+            def __init__(self, value: int) -> None:
+                if value >= self.MAX_VALUE:
+                    raise ValueError(f"{value} is not below {self.MAX_VALUE}")
+
+        BoundedInt(0) + 0
+        refs.append(weakref.ref(BoundedInt))
+    return refs
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--count", type=int, default=100_000)
+    parser.add_argument("--limit-mb", type=float, default=32.0)
+    args = parser.parse_args()
+
+    churn(max(args.count // 10, 1))
+    gc.collect()
+    start = rss_mb()
+
+    refs = churn(args.count)
+    gc.collect()
+    alive = sum(ref() is not None for ref in refs)
+    growth = rss_mb() - start
+
+    print(f"classes created: {args.count}, still alive: {alive}")
+    print(f"RSS growth after warm-up: {growth:.1f} MB (limit {args.limit_mb} MB)")
+    return 1 if alive or growth > args.limit_mb else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
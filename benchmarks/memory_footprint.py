@@ -0,0 +1,238 @@
+"""Memory benchmark: the footprint of NewType instances, per base type.
+
+For every base type this compares a trivial NewType over it with the bare base type:
+    - bytes/instance: the memory each live instance holds, measured over many of
+      them kept alive at once
+    - construct peak: the peak memory while building them all
+    - chain peak: the peak memory while calling a chain of rewrapping methods on
+      each of them, keeping the results
+
+Peaks are taken with memray when it is installed (the `profiling` dependency group),
+which also sees allocations made by C libraries such as numpy. Otherwise they are
+taken with `tracemalloc`. Bytes per instance always come from `tracemalloc`, which
+can tell the memory still held apart from the memory that was freed.
+
+Each base type has a budget: the bytes an instance may hold over a base-type value,
+and how much higher than for the base type the peaks may be. The script exits with
+status 1 if one is exceeded. Base types whose module cannot be imported, such as
+`pandas.DataFrame`, are skipped.
+
+Usage:
+    python benchmarks/memory_footprint.py [--count 100000] [--output FILE] [--only str,int]
+"""
+
+import argparse
+import gc
+import json
+import platform
+import sys
+import tempfile
+import tracemalloc
+import warnings
+from pathlib import Path
+from typing import Any, Callable, Dict, List
+
+import newtype
+from newtype import NewType
+
+
+try:
+    import memray
+except ImportError:  # not installed, or not available on this platform
+    memray = None
+
+
+class Point:
+    def __init__(self, x: int, y: int) -> None:
+        self.x = x
+        self.y = y
+
+    def moved(self, dx: int) -> "Point":
+        return Point(self.x + dx, self.y)
+
+
+class SlotPoint:
+    __slots__ = ("x", "y")
+
+    def __init__(self, x: int, y: int) -> None:
+        self.x = x
+        self.y = y
+
+    def moved(self, dx: int) -> "SlotPoint":
+        return SlotPoint(self.x + dx, self.y)
+
+
+# Each case gives the base type, a function making the `i`-th base-type value, a
+# chain of rewrapping methods, the share of `--count` to build, and the budget:
+# `extra_bytes` per instance over the base type, and the most the peaks may be
+# over those of the base type. The budgets are the current figures plus a margin.
+CASES: "Dict[str, Callable[[], Dict[str, Any]]]" = {
+    "str": lambda: {
+        "base": str,
+        "make": lambda i: f"user-{i:08d}",
+        "chain": lambda x: x.strip().upper().replace("-", "_"),
+        "extra_bytes": 192,
+        "construct_ratio": 4.0,
+        "chain_ratio": 3.0,
+    },
+    "int": lambda: {
+        "base": int,
+        "make": lambda i: 1_000_000 + i,
+        "chain": lambda x: (x + 1) * 2 - 3,
+        "extra_bytes": 320,
+        "construct_ratio": 9.0,
+        "chain_ratio": 7.5,
+    },
+    "slots": lambda: {
+        "base": SlotPoint,
+        "make": lambda i: SlotPoint(i, i),
+        "chain": lambda x: x.moved(1).moved(2),
+        "extra_bytes": 144,
+        "construct_ratio": 3.0,
+        "chain_ratio": 3.0,
+    },
+    "object": lambda: {
+        "base": Point,
+        "make": lambda i: Point(i, i),
+        "chain": lambda x: x.moved(1).moved(2),
+        "extra_bytes": 96,
+        "construct_ratio": 2.0,
+        "chain_ratio": 6.0,
+    },
+    "DataFrame": lambda: dataframe_case(),
+}
+
+
+def dataframe_case() -> "Dict[str, Any]":
+    import pandas as pd  # noqa: PLC0415
+
+    # copying the attributes of a frame onto its NewType instance goes through
+    # `DataFrame.__setattr__`, which warns about every one of them
+    warnings.filterwarnings("ignore", message="Pandas doesn't allow columns")
+
+    return {
+        "base": pd.DataFrame,
+        "make": lambda i: pd.DataFrame({"a": [i, i + 1, i + 2], "b": [0.5, 1.5, 2.5]}),
+        "chain": lambda x: (x + 1) * 2,
+        "scale": 0.01,
+        "extra_bytes": 512,
+        "construct_ratio": 1.5,
+        "chain_ratio": 3.5,
+    }
+
+
+def bytes_per_instance(make: "Callable[[], Any]", count: int) -> float:
+    make()  # let caches and free-lists fill first
+    gc.collect()
+    tracemalloc.start()
+    before, _ = tracemalloc.get_traced_memory()
+    kept = [make() for _ in range(count)]
+    after, _ = tracemalloc.get_traced_memory()
+    tracemalloc.stop()
+    del kept
+    return (after - before) / count
+
+
+def peak_bytes(run: "Callable[[], Any]") -> int:
+    """Return the peak memory allocated while `run()` runs, over what it started with."""
+    gc.collect()
+    if memray is not None:
+        with tempfile.TemporaryDirectory() as tmp:
+            path = Path(tmp) / "peak.bin"
+            with memray.Tracker(path):
+                result = run()
+                del result
+            return int(memray.FileReader(path).metadata.peak_memory)
+    tracemalloc.start()
+    result = run()
+    del result
+    _, peak = tracemalloc.get_traced_memory()
+    tracemalloc.stop()
+    return peak
+
+
+def run_case(case: "Dict[str, Any]", count: int) -> "Dict[str, Dict[str, float]]":
+    base, make, chain = case["base"], case["make"], case["chain"]
+    count = max(1, int(count * case.get("scale", 1)))
+
+    class Wrapped(NewType(base)):  # type: ignore[misc, valid-type]
+        pass
+
+    results: Dict[str, Dict[str, float]] = {}
+    for label, build in (("plain", make), ("newtype", lambda i: Wrapped(make(i)))):
+        counter = iter(range(count + 1))
+        items = [build(i) for i in range(count)]
+        results[label] = {
+            "bytes_per_instance": round(
+                bytes_per_instance(lambda: build(next(counter)), count),  # noqa: B023
+                1,
+            ),
+            "construct_peak": peak_bytes(lambda: [build(i) for i in range(count)]),  # noqa: B023
+            "chain_peak": peak_bytes(lambda: [chain(x) for x in items]),  # noqa: B023
+        }
+    return results
+
+
+def check(name: str, case: "Dict[str, Any]", results: "Dict[str, Any]") -> "List[str]":
+    """Return a line for every measure of `name` over its budget."""
+    plain, wrapped = results["plain"], results["newtype"]
+    failures = []
+    extra = wrapped["bytes_per_instance"] - plain["bytes_per_instance"]
+    if extra > case["extra_bytes"]:
+        failures.append(f"{name}: {extra:.0f} extra bytes/instance (budget {case['extra_bytes']})")
+    for peak in ("construct", "chain"):
+        ratio = wrapped[f"{peak}_peak"] / max(plain[f"{peak}_peak"], 1)
+        if ratio > case[f"{peak}_ratio"]:
+            failures.append(f"{name}: {peak} peak x{ratio:.2f} (budget x{case[f'{peak}_ratio']})")
+    return failures
+
+
+def metadata() -> "Dict[str, Any]":
+    return {
+        "python": platform.python_version(),
+        "implementation": platform.python_implementation(),
+        "platform": platform.platform(),
+        "newtype": newtype.__version__,
+        "tracer": "memray" if memray is not None else "tracemalloc",
+    }
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--count", type=int, default=100_000)
+    parser.add_argument("--output", type=Path, help="write the results to this JSON file")
+    parser.add_argument("--only", help="comma-separated base types to run")
+    args = parser.parse_args()
+
+    names = args.only.split(",") if args.only else list(CASES)
+    results: Dict[str, Any] = {}
+    failures: List[str] = []
+    print(f"peaks measured with {metadata()['tracer']}")
+    print(
+        f"{'base type':<12}{'flavour':<10}{'bytes/instance':>16}{'construct peak':>16}{'chain peak':>14}"
+    )
+    for name in names:
+        try:
+            case = CASES[name]()
+        except ImportError as e:
+            print(f"{name:<12}skipped: {e}")
+            continue
+        results[name] = run_case(case, args.count)
+        for label, measures in results[name].items():
+            print(
+                f"{name:<12}{label:<10}{measures['bytes_per_instance']:>16.1f}"
+                f"{measures['construct_peak']:>16,}{measures['chain_peak']:>14,}"
+            )
+        failures += check(name, case, results[name])
+
+    if args.output:
+        args.output.parent.mkdir(parents=True, exist_ok=True)
+        args.output.write_text(json.dumps({"meta": metadata(), "results": results}, indent=2))
+
+    for line in failures:
+        print(f"OVER BUDGET {line}")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,97 @@
+"""Memory benchmark: instance dicts of NewTypes over `object` bases.
+
+CPython shares the keys of the instance dicts of a class among its instances
+(PEP 412), which stores a dict as little more than an array of values. A dict whose
+attributes were added out of order, or that was built on another class's keys,
+gets a table of its own instead. For millions of instances that is gigabytes.
+
+For every way of building a NewType instance this prints the memory allocated per
+instance and whether its dict still shares keys. It exits with status 1 if one
+does not.
+
+Usage:
+    python benchmarks/memory_split_dicts.py [--count N]
+"""
+
+import argparse
+import sys
+import tracemalloc
+from typing import Any, Callable, Dict, List, Tuple
+
+from newtype import NewType
+
+
+class Point:
+    def __init__(self, x: int, y: int) -> None:
+        self.x = x
+        self.y = y
+        self.z = 0
+        self.w = 1
+
+    def moved(self, dx: int) -> "Point":
+        return Point(self.x + dx, self.y)
+
+
+class Position(NewType(Point)):  # type: ignore[misc]
+    def __init__(self, point: Point, frame: str = "world") -> None:
+        self.frame = frame
+
+
+class CustomNew(NewType(Point)):  # type: ignore[misc]
+    def __new__(cls, *args: Any, **kwargs: Any) -> "CustomNew":
+        return super().__new__(cls, *args, **kwargs)  # type: ignore[no-any-return]
+
+    def __init__(self, point: Point, frame: str = "world") -> None:
+        self.frame = frame
+
+
+POSITION = Position(Point(0, 0))
+CUSTOM = CustomNew(Point(0, 0))
+
+CASES: "Dict[str, Callable[[int], Any]]" = {
+    "plain object": lambda i: Point(i, i),
+    "construct": lambda i: Position(Point(i, i)),
+    "unsafe_cast": lambda i: Position.unsafe_cast(Point(i, i)),
+    "rewrap": lambda i: POSITION.moved(i),
+    "rewrap, own __new__": lambda i: CUSTOM.moved(i),
+}
+
+
+def shares_keys(obj: Any) -> bool:
+    """Whether the `__dict__` of `obj` is a split table.
+
+    A split dict reports the size of its values only, a combined copy of it also
+    that of its keys.
+    """
+    d = vars(obj)
+    return sys.getsizeof(d) < sys.getsizeof(dict(d))
+
+
+def measure(make: "Callable[[int], Any]", count: int) -> "Tuple[float, bool]":
+    make(-1)  # let the class build its shared keys first
+    kept: List[Any] = []
+    tracemalloc.start()
+    before, _ = tracemalloc.get_traced_memory()
+    for i in range(count):
+        kept.append(make(i))
+    after, _ = tracemalloc.get_traced_memory()
+    tracemalloc.stop()
+    return (after - before) / count, all(shares_keys(obj) for obj in kept[-10:])
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--count", type=int, default=100_000)
+    args = parser.parse_args()
+
+    failed = False
+    print(f"{'case':<20}{'bytes/instance':>16}  shared keys")
+    for name, make in CASES.items():
+        per_instance, shared = measure(make, args.count)
+        failed |= not shared
+        print(f"{name:<20}{per_instance:>16.1f}  {'yes' if shared else 'NO'}")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
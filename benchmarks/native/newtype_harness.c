@@ -0,0 +1,414 @@
+// Native benchmark harness for the NewType descriptors.
+//
+// Embeds the interpreter, binds `NewTypeMethod` and `NewTypeInit` descriptors
+// once, and calls their `tp_call` in tight loops, so that the measurements
+// hold the descriptor code and what it calls, without the evaluation loop
+// around it. Plain methods of the base types run the same way, for reference.
+//
+// For every case it reports:
+//   - ns/op, from `CLOCK_MONOTONIC`
+//   - instructions, branch misses and L1 data cache read misses per op, from
+//     Linux `perf_event_open`, counting user space only; "n/a" where the
+//     kernel or the machine provides no such counter
+//   - allocations per op, counted by hooks wrapping the `PyMem` allocators
+//
+// Built by `__PYNT_HARNESS__=true python build.py` into `build/harness/`; run
+// it from the project root, where it imports `newtype` from:
+//     build/harness/newtype_harness [iterations] [case-substring]
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// `sys.executable` of the interpreter the harness was built against, from
+// which the embedded interpreter finds its standard library
+#ifndef NEWTYPE_HARNESS_PYTHON
+#define NEWTYPE_HARNESS_PYTHON "python3"
+#endif
+
+#define HARNESS_DEFAULT_ITERATIONS 200000
+#define HARNESS_WARMUP_ITERATIONS 1000
+
+// Cases: the first item of each is its name, then the descriptor or callable,
+// then the instance and class to bind a descriptor to (None for a plain
+// callable), then the arguments of each call
+static const char HARNESS_SETUP[] =
+    "import os, sys\n"
+    "sys.path.insert(0, os.getcwd())\n"
+    "from newtype import NewType\n"
+    "\n"
+    "class Text(NewType(str)):\n"
+    "    pass\n"
+    "\n"
+    "class Count(NewType(int)):\n"
+    "    pass\n"
+    "\n"
+    "class Checked(NewType(str)):\n"
+    "    def __init__(self, value):\n"
+    "        if not value:\n"
+    "            raise ValueError('empty')\n"
+    "\n"
+    "class Point:\n"
+    "    def __init__(self, x, y):\n"
+    "        self.x = x\n"
+    "        self.y = y\n"
+    "\n"
+    "    def moved(self, dx):\n"
+    "        return Point(self.x + dx, self.y)\n"
+    "\n"
+    "class Position(NewType(Point)):\n"
+    "    pass\n"
+    "\n"
+    "text, count = Text('hello world'), Count(12345)\n"
+    "checked, position = Checked('hello'), Position(Point(1, 2))\n"
+    "CASES = [\n"
+    "    ('str.upper plain', str.upper, None, None, ('hello world',)),\n"
+    "    ('str.upper rewrap', vars(Text)['upper'], text, Text, ()),\n"
+    "    ('str.startswith passthrough', vars(Text)['startswith'], text, Text,\n"
+    "     ('he',)),\n"
+    "    ('int.__add__ plain', int.__add__, None, None, (12345, 1)),\n"
+    "    ('int.__add__ rewrap', vars(Count)['__add__'], count, Count, (1,)),\n"
+    "    ('Point.moved plain', Point.moved, None, None, (Point(1, 2), 1)),\n"
+    "    ('Point.moved rewrap', vars(Position)['moved'], position, Position,\n"
+    "     (1,)),\n"
+    "    ('NewTypeInit default', vars(Text)['__init__'], text, Text,\n"
+    "     ('hello world',)),\n"
+    "    ('NewTypeInit user __init__', vars(Checked)['__init__'], checked,\n"
+    "     Checked, ('hello',)),\n"
+    "    ('Text() construct', Text, None, None, ('hello world',)),\n"
+    "]\n";
+
+// Allocation counting
+
+typedef struct {
+  PyMemAllocatorEx wrapped;
+  unsigned long long* count;
+} HarnessAllocator;
+
+static unsigned long long HARNESS_ALLOCS = 0;
+static int HARNESS_COUNTING = 0;
+static HarnessAllocator HARNESS_ALLOCATORS[3];
+
+static void* harness_malloc(void* ctx, size_t size)
+{
+  HarnessAllocator* a = (HarnessAllocator*)ctx;
+  *a->count += HARNESS_COUNTING;
+  return a->wrapped.malloc(a->wrapped.ctx, size);
+}
+
+static void* harness_calloc(void* ctx, size_t nelem, size_t elsize)
+{
+  HarnessAllocator* a = (HarnessAllocator*)ctx;
+  *a->count += HARNESS_COUNTING;
+  return a->wrapped.calloc(a->wrapped.ctx, nelem, elsize);
+}
+
+static void* harness_realloc(void* ctx, void* ptr, size_t new_size)
+{
+  HarnessAllocator* a = (HarnessAllocator*)ctx;
+  *a->count += HARNESS_COUNTING;
+  return a->wrapped.realloc(a->wrapped.ctx, ptr, new_size);
+}
+
+static void harness_free(void* ctx, void* ptr)
+{
+  HarnessAllocator* a = (HarnessAllocator*)ctx;
+  a->wrapped.free(a->wrapped.ctx, ptr);
+}
+
+// Wraps the allocators of every domain, as `tracemalloc` does; the counter
+// is only bumped while `HARNESS_COUNTING` is set
+static void harness_hook_allocators(void)
+{
+  static const PyMemAllocatorDomain domains[3] = {
+      PYMEM_DOMAIN_RAW, PYMEM_DOMAIN_MEM, PYMEM_DOMAIN_OBJ};
+  int i;
+
+  for (i = 0; i < 3; i++) {
+    PyMemAllocatorEx hook;
+    HarnessAllocator* a = &HARNESS_ALLOCATORS[i];
+
+    PyMem_GetAllocator(domains[i], &a->wrapped);
+    a->count = &HARNESS_ALLOCS;
+    hook.ctx = a;
+    hook.malloc = harness_malloc;
+    hook.calloc = harness_calloc;
+    hook.realloc = harness_realloc;
+    hook.free = harness_free;
+    PyMem_SetAllocator(domains[i], &hook);
+  }
+}
+
+// Hardware counters
+
+enum {
+  COUNTER_INSTRUCTIONS,
+  COUNTER_BRANCH_MISSES,
+  COUNTER_L1D_MISSES,
+  COUNTER_COUNT
+};
+
+static const char* const COUNTER_NAMES[COUNTER_COUNT] = {
+    "instr/op", "br-miss/op", "L1d-miss/op"};
+
+typedef struct {
+  int fd[COUNTER_COUNT];  // -1 for the counters that could not be opened
+  unsigned long long value[COUNTER_COUNT];
+} HarnessCounters;
+
+#ifdef __linux__
+static int harness_open_counter(uint32_t type, uint64_t config)
+{
+  struct perf_event_attr attr;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+static void harness_open_counters(HarnessCounters* c)
+{
+  int i;
+
+  for (i = 0; i < COUNTER_COUNT; i++) {
+    c->fd[i] = -1;
+  }
+#ifdef __linux__
+  c->fd[COUNTER_INSTRUCTIONS] = harness_open_counter(
+      PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+  c->fd[COUNTER_BRANCH_MISSES] = harness_open_counter(
+      PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+  c->fd[COUNTER_L1D_MISSES] =
+      harness_open_counter(PERF_TYPE_HW_CACHE,
+                           PERF_COUNT_HW_CACHE_L1D
+                               | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                               | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+  if (c->fd[COUNTER_INSTRUCTIONS] < 0) {
+    perror("perf_event_open");
+  }
+#endif
+}
+
+static void harness_start_counters(HarnessCounters* c)
+{
+#ifdef __linux__
+  int i;
+  for (i = 0; i < COUNTER_COUNT; i++) {
+    if (c->fd[i] >= 0) {
+      ioctl(c->fd[i], PERF_EVENT_IOC_RESET, 0);
+      ioctl(c->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#else
+  (void)c;
+#endif
+}
+
+static void harness_stop_counters(HarnessCounters* c)
+{
+  int i;
+  for (i = 0; i < COUNTER_COUNT; i++) {
+    c->value[i] = 0;
+#ifdef __linux__
+    if (c->fd[i] >= 0) {
+      ioctl(c->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+      if (read(c->fd[i], &c->value[i], sizeof(c->value[i]))
+          != sizeof(c->value[i]))
+      {
+        c->value[i] = 0;
+      }
+    }
+#endif
+  }
+}
+
+static void harness_close_counters(HarnessCounters* c)
+{
+#ifdef __linux__
+  int i;
+  for (i = 0; i < COUNTER_COUNT; i++) {
+    if (c->fd[i] >= 0) {
+      close(c->fd[i]);
+    }
+  }
+#else
+  (void)c;
+#endif
+}
+
+static double harness_now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Runs `callable(*args)` `n` times through its `tp_call`, dropping the
+// results; returns -1 with an exception set if a call fails
+static int harness_loop(PyObject* callable, PyObject* args, long n)
+{
+  ternaryfunc call = Py_TYPE(callable)->tp_call;
+  long i;
+
+  for (i = 0; i < n; i++) {
+    PyObject* result = call(callable, args, NULL);
+    if (result == NULL) {
+      return -1;
+    }
+    Py_DECREF(result);
+  }
+  return 0;
+}
+
+static int harness_run_case(PyObject* spec, long n, HarnessCounters* counters)
+{
+  PyObject *name, *target, *obj, *cls, *args, *callable;
+  double start, elapsed = 0.0;
+  unsigned long long allocs = 0;
+  int i, r;
+
+  if (!PyArg_ParseTuple(spec, "UOOOO!", &name, &target, &obj, &cls,
+                        &PyTuple_Type, &args))
+  {
+    return -1;
+  }
+  if (obj == Py_None) {
+    callable = target;
+    Py_INCREF(callable);
+  } else if (Py_TYPE(target)->tp_descr_get != NULL) {
+    // `NewTypeMethod` and `NewTypeInit` return themselves, bound to `obj`
+    callable = Py_TYPE(target)->tp_descr_get(target, obj, cls);
+    if (callable == NULL) {
+      return -1;
+    }
+  } else {
+    PyErr_Format(PyExc_TypeError, "%R is not a descriptor", target);
+    return -1;
+  }
+
+  r = harness_loop(callable, args, HARNESS_WARMUP_ITERATIONS);
+  if (r == 0) {
+    HARNESS_ALLOCS = 0;
+    HARNESS_COUNTING = 1;
+    harness_start_counters(counters);
+    start = harness_now_ns();
+    r = harness_loop(callable, args, n);
+    elapsed = harness_now_ns() - start;
+    harness_stop_counters(counters);
+    HARNESS_COUNTING = 0;
+    allocs = HARNESS_ALLOCS;
+  }
+  Py_DECREF(callable);
+  if (r < 0) {
+    return -1;
+  }
+
+  printf("%-30s %10.1f", PyUnicode_AsUTF8(name), elapsed / (double)n);
+  for (i = 0; i < COUNTER_COUNT; i++) {
+    if (counters->fd[i] >= 0) {
+      printf(" %12.1f", (double)counters->value[i] / (double)n);
+    } else {
+      printf(" %12s", "n/a");
+    }
+  }
+  printf(" %10.2f\n", (double)allocs / (double)n);
+  return 0;
+}
+
+static int harness_run(long n, const char* filter)
+{
+  PyObject *main_module, *globals, *result, *cases;
+  HarnessCounters counters;
+  Py_ssize_t i;
+  int r = 0;
+
+  main_module = PyImport_AddModule("__main__");  // borrowed
+  if (main_module == NULL) {
+    return -1;
+  }
+  globals = PyModule_GetDict(main_module);  // borrowed
+  result = PyRun_String(HARNESS_SETUP, Py_file_input, globals, globals);
+  if (result == NULL) {
+    return -1;
+  }
+  Py_DECREF(result);
+  cases = PyDict_GetItemString(globals, "CASES");  // borrowed
+  if (cases == NULL || !PyList_Check(cases)) {
+    PyErr_SetString(PyExc_RuntimeError, "the setup defines no `CASES` list");
+    return -1;
+  }
+
+  harness_open_counters(&counters);
+  harness_hook_allocators();
+  printf("%-30s %10s", "case", "ns/op");
+  for (i = 0; i < COUNTER_COUNT; i++) {
+    printf(" %12s", COUNTER_NAMES[i]);
+  }
+  printf(" %10s\n", "allocs/op");
+
+  for (i = 0; i < PyList_GET_SIZE(cases) && r == 0; i++) {
+    PyObject* spec = PyList_GET_ITEM(cases, i);
+    PyObject* name = PyTuple_Check(spec) && PyTuple_GET_SIZE(spec) > 0
+                         ? PyTuple_GET_ITEM(spec, 0)
+                         : NULL;
+    if (filter != NULL && name != NULL && PyUnicode_Check(name)
+        && strstr(PyUnicode_AsUTF8(name), filter) == NULL)
+    {
+      continue;
+    }
+    r = harness_run_case(spec, n, &counters);
+  }
+  harness_close_counters(&counters);
+  return r;
+}
+
+int main(int argc, char** argv)
+{
+  PyConfig config;
+  PyStatus status;
+  long n = argc > 1 ? strtol(argv[1], NULL, 10) : HARNESS_DEFAULT_ITERATIONS;
+  const char* filter = argc > 2 ? argv[2] : NULL;
+  int r;
+
+  if (n <= 0) {
+    fprintf(stderr, "usage: %s [iterations] [case-substring]\n", argv[0]);
+    return 2;
+  }
+
+  PyConfig_InitPythonConfig(&config);
+  status = PyConfig_SetBytesString(
+      &config, &config.program_name, NEWTYPE_HARNESS_PYTHON);
+  if (!PyStatus_Exception(status)) {
+    status = Py_InitializeFromConfig(&config);
+  }
+  PyConfig_Clear(&config);
+  if (PyStatus_Exception(status)) {
+    Py_ExitStatusException(status);
+  }
+
+  r = harness_run(n, filter);
+  if (r < 0) {
+    PyErr_Print();
+  }
+  if (Py_FinalizeEx() < 0) {
+    return 120;
+  }
+  return r < 0 ? 1 : 0;
+}
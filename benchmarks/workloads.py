@@ -0,0 +1,349 @@
+"""Macro-benchmark: realistic workloads with plain types, `typing.NewType` and NewType.
+
+Each workload runs the same job three ways:
+    - plain: on the bare base type, validating with ordinary functions
+    - typing: with `typing.NewType`, which only exists for the type checker, and the
+      same validating functions
+    - newtype: with a `newtype.NewType` subtype that validates in `__init__`, and
+      again on every method result
+
+The workloads are:
+    - emails: parse and normalise 1M raw email addresses, counting them by domain
+    - money: 10M multiply-and-add steps on integer cents
+    - ids: build a dict of 1M entries keyed by user ids, then look each one up
+    - frames: a transform pipeline over 1000 `pandas.DataFrame` batches of 1000 rows
+
+All data is generated from a fixed seed, and every flavour of a workload must give
+the same result. Each time is the best of `--repeat` runs, one by default, as each
+run is long enough to be steady; the ratio is over the plain flavour. `--scale` multiplies the sizes, e.g. `--scale 0.1` for a quick run.
+Workloads whose module cannot be imported, such as pandas, are skipped.
+
+Usage:
+    python benchmarks/workloads.py [--scale 1.0] [--repeat 1] [--seed 0]
+        [--output FILE] [--only emails,money]
+"""
+
+import argparse
+import json
+import platform
+import random
+import sys
+import time
+import typing
+import warnings
+from collections import Counter
+from pathlib import Path
+from typing import Any, Callable, Dict, List
+
+import newtype
+from newtype import NewType
+
+
+FLAVOURS = ("plain", "typing", "newtype")
+
+
+# --- emails -----------------------------------------------------------------------
+
+FIRST_NAMES = ("ada", "alan", "grace", "linus", "guido", "barbara", "ken", "margaret")
+DOMAINS = ("Example.COM", "mail.example.org", "CORP.example.net", "example.io")
+
+TypingEmail = typing.NewType("TypingEmail", str)
+
+
+class Email(NewType(str)):  # type: ignore[misc]
+    def __init__(self, value: str) -> None:
+        if "@" not in value:
+            raise ValueError(f"{value!r} is not an email address")
+
+
+def check_email(value: str) -> str:
+    if "@" not in value:
+        raise ValueError(f"{value!r} is not an email address")
+    return value
+
+
+def email_data(rng: random.Random, scale: float) -> "List[str]":
+    raws = []
+    for i in range(int(1_000_000 * scale)):
+        at = "" if rng.random() < 0.01 else "@"  # one in a hundred is invalid
+        raws.append(f"  {rng.choice(FIRST_NAMES)}.{i}{at}{rng.choice(DOMAINS)} ")
+    return raws
+
+
+def emails_plain(raws: "List[str]") -> Any:
+    domains: Counter = Counter()
+    for raw in raws:
+        try:
+            email = check_email(raw.strip().lower())
+        except ValueError:
+            continue
+        domains[email.partition("@")[2]] += 1
+    return sorted(domains.items())
+
+
+def emails_typing(raws: "List[str]") -> Any:
+    domains: Counter = Counter()
+    for raw in raws:
+        try:
+            email = TypingEmail(check_email(raw.strip().lower()))
+        except ValueError:
+            continue
+        domains[email.partition("@")[2]] += 1
+    return sorted(domains.items())
+
+
+def emails_newtype(raws: "List[str]") -> Any:
+    domains: Counter = Counter()
+    for raw in raws:
+        try:
+            email = Email(raw).strip().lower()
+        except ValueError:
+            continue
+        domains[email.partition("@")[2]] += 1
+    return sorted(domains.items())
+
+
+# --- money ------------------------------------------------------------------------
+
+TypingCents = typing.NewType("TypingCents", int)
+
+
+class Cents(NewType(int)):  # type: ignore[misc]
+    def __init__(self, value: int) -> None:
+        if value < 0:
+            raise ValueError(f"{value} cents is negative")
+
+
+def check_cents(value: int) -> int:
+    if value < 0:
+        raise ValueError(f"{value} cents is negative")
+    return value
+
+
+# the steps cycle through a table of prices and quantities, so that 10M steps do
+# not need 10M objects
+MONEY_TABLE_SIZE = 10_000
+
+
+def money_data(rng: random.Random, scale: float) -> "Dict[str, Any]":
+    table = [(rng.randrange(1, 100_000), rng.randrange(1, 20)) for _ in range(MONEY_TABLE_SIZE)]
+    return {"table": table, "steps": int(10_000_000 * scale)}
+
+
+def money_plain(data: "Dict[str, Any]") -> Any:
+    table, size = data["table"], len(data["table"])
+    total = check_cents(0)
+    for i in range(data["steps"]):
+        price, quantity = table[i % size]
+        total = check_cents(total + price * quantity)
+    return total
+
+
+def money_typing(data: "Dict[str, Any]") -> Any:
+    table = [(TypingCents(check_cents(price)), quantity) for price, quantity in data["table"]]
+    size = len(table)
+    total = TypingCents(check_cents(0))
+    for i in range(data["steps"]):
+        price, quantity = table[i % size]
+        total = TypingCents(check_cents(total + price * quantity))
+    return total
+
+
+def money_newtype(data: "Dict[str, Any]") -> Any:
+    table = [(Cents(price), quantity) for price, quantity in data["table"]]
+    size = len(table)
+    total = Cents(0)
+    for i in range(data["steps"]):
+        price, quantity = table[i % size]
+        total = total + price * quantity
+    return total
+
+
+# --- ids --------------------------------------------------------------------------
+
+TypingUserId = typing.NewType("TypingUserId", str)
+
+
+class UserId(NewType(str)):  # type: ignore[misc]
+    def __init__(self, value: str) -> None:
+        if not value.startswith("u"):
+            raise ValueError(f"{value!r} is not a user id")
+
+
+def check_user_id(value: str) -> str:
+    if not value.startswith("u"):
+        raise ValueError(f"{value!r} is not a user id")
+    return value
+
+
+def id_data(rng: random.Random, scale: float) -> "Dict[str, Any]":
+    ids = [f"u{i:07d}" for i in range(int(1_000_000 * scale))]
+    queries = list(ids)
+    rng.shuffle(queries)
+    return {"ids": ids, "queries": queries}
+
+
+def ids_plain(data: "Dict[str, Any]") -> Any:
+    table = {check_user_id(raw): i for i, raw in enumerate(data["ids"])}
+    return sum(table[check_user_id(raw)] for raw in data["queries"])
+
+
+def ids_typing(data: "Dict[str, Any]") -> Any:
+    table = {TypingUserId(check_user_id(raw)): i for i, raw in enumerate(data["ids"])}
+    return sum(table[TypingUserId(check_user_id(raw))] for raw in data["queries"])
+
+
+def ids_newtype(data: "Dict[str, Any]") -> Any:
+    table = {UserId(raw): i for i, raw in enumerate(data["ids"])}
+    return sum(table[UserId(raw)] for raw in data["queries"])
+
+
+# --- frames -----------------------------------------------------------------------
+
+
+def frame_workload() -> "Dict[str, Any]":
+    import numpy as np  # noqa: PLC0415
+    import pandas as pd  # noqa: PLC0415
+
+    # copying the attributes of a frame onto its NewType instance goes through
+    # `DataFrame.__setattr__`, which warns about every one of them
+    warnings.filterwarnings("ignore", message="Pandas doesn't allow columns")
+
+    TypingFrame = typing.NewType("TypingFrame", pd.DataFrame)
+
+    class Frame(NewType(pd.DataFrame)):  # type: ignore[misc]
+        def __init__(self, value: pd.DataFrame) -> None:
+            if value.shape[1] == 0:
+                raise ValueError("a frame needs columns")
+
+    def check_frame(value: pd.DataFrame) -> pd.DataFrame:
+        if value.shape[1] == 0:
+            raise ValueError("a frame needs columns")
+        return value
+
+    # methods that end in `__finalize__`, such as `clip()`, `astype()` or aligning a
+    # frame with a `Series`, fail on a rewrapped frame, whose `flags` refer to the
+    # frame it was built from; the pipeline keeps to scalar operators and reductions
+    def transform(frame: Any, wrap: "Callable[[Any], Any]") -> float:
+        scores = wrap((frame - 0.5) * 2.0)
+        scores = wrap(scores**2 + scores)
+        outliers = wrap(scores > 2.0)
+        return float((scores * outliers).sum().sum())
+
+    def data(rng: random.Random, scale: float) -> "List[Any]":
+        gen = np.random.default_rng(rng.randrange(2**32))
+        return [
+            pd.DataFrame(gen.normal(size=(1000, 4)), columns=["a", "b", "c", "d"])
+            for _ in range(int(1000 * scale))
+        ]
+
+    def frames_plain(batches: "List[Any]") -> Any:
+        return round(sum(transform(check_frame(b), check_frame) for b in batches), 6)
+
+    def frames_typing(batches: "List[Any]") -> Any:
+        def wrap(value: Any) -> Any:
+            return TypingFrame(check_frame(value))
+
+        return round(sum(transform(wrap(b), wrap) for b in batches), 6)
+
+    def frames_newtype(batches: "List[Any]") -> Any:
+        # operators on a `Frame` already return `Frame`s, validated
+        return round(sum(transform(Frame(b), lambda value: value) for b in batches), 6)
+
+    return {
+        "data": data,
+        "plain": frames_plain,
+        "typing": frames_typing,
+        "newtype": frames_newtype,
+    }
+
+
+WORKLOADS: "Dict[str, Callable[[], Dict[str, Any]]]" = {
+    "emails": lambda: {
+        "data": email_data,
+        "plain": emails_plain,
+        "typing": emails_typing,
+        "newtype": emails_newtype,
+    },
+    "money": lambda: {
+        "data": money_data,
+        "plain": money_plain,
+        "typing": money_typing,
+        "newtype": money_newtype,
+    },
+    "ids": lambda: {
+        "data": id_data,
+        "plain": ids_plain,
+        "typing": ids_typing,
+        "newtype": ids_newtype,
+    },
+    "frames": lambda: frame_workload(),
+}
+
+
+def run_workload(
+    workload: "Dict[str, Any]", data: Any, repeat: int
+) -> "Dict[str, Dict[str, float]]":
+    times: Dict[str, float] = {}
+    results: Dict[str, Any] = {}
+    for flavour in FLAVOURS:
+        best = float("inf")
+        for _ in range(repeat):
+            start = time.perf_counter()
+            results[flavour] = workload[flavour](data)
+            best = min(best, time.perf_counter() - start)
+        times[flavour] = best
+    if any(results[flavour] != results["plain"] for flavour in FLAVOURS):
+        raise AssertionError(f"the flavours disagree: {results}")
+    return {
+        flavour: {
+            "seconds": round(times[flavour], 4),
+            "ratio": round(times[flavour] / times["plain"], 3),
+        }
+        for flavour in FLAVOURS
+    }
+
+
+def metadata(args: argparse.Namespace) -> "Dict[str, Any]":
+    return {
+        "python": platform.python_version(),
+        "implementation": platform.python_implementation(),
+        "platform": platform.platform(),
+        "newtype": newtype.__version__,
+        "scale": args.scale,
+        "seed": args.seed,
+        "timestamp": time.strftime("%Y-%m-%dT%H:%M:%S%z"),
+    }
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--scale", type=float, default=1.0)
+    parser.add_argument("--repeat", type=int, default=1)
+    parser.add_argument("--seed", type=int, default=0)
+    parser.add_argument("--output", type=Path, help="write the results to this JSON file")
+    parser.add_argument("--only", help="comma-separated workloads to run")
+    args = parser.parse_args()
+
+    names = args.only.split(",") if args.only else list(WORKLOADS)
+    results: Dict[str, Any] = {}
+    print(f"{'workload':<10}{'flavour':<10}{'seconds':>10}{'ratio':>8}")
+    for name in names:
+        try:
+            workload = WORKLOADS[name]()
+        except ImportError as e:
+            print(f"{name:<10}skipped: {e}")
+            continue
+        data = workload["data"](random.Random(args.seed), args.scale)  # noqa: S311
+        results[name] = run_workload(workload, data, args.repeat)
+        for flavour, timing in results[name].items():
+            print(f"{name:<10}{flavour:<10}{timing['seconds']:>10.3f}{timing['ratio']:>8.2f}")
+
+    if args.output:
+        args.output.parent.mkdir(parents=True, exist_ok=True)
+        args.output.write_text(json.dumps({"meta": metadata(args), "results": results}, indent=2))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -4,6 +4,7 @@ import os
 from pathlib import Path
 import shutil
 import sys
+import sysconfig
 from tomli import load
 
 from setuptools import Extension  # noqa: I001
@@ -21,6 +22,12 @@ LOGGER.info("Running `build.py`...")
 
 debug_print = (os.getenv("__PYNT_DEBUG__") == "true") or False
 LOGGER.info(f"`debug_print` = {debug_print}")
+# compile in the USDT probes of `newtype_probes.h`, given <sys/sdt.h>
+usdt_probes = (os.getenv("__PYNT_USDT__") == "true") or False
+LOGGER.info(f"`usdt_probes` = {usdt_probes}")
+# also build the native benchmark harness, `benchmarks/native/newtype_harness.c`
+build_harness = (os.getenv("__PYNT_HARNESS__") == "true") or False
+LOGGER.info(f"`build_harness` = {build_harness}")
 
 
 def list_dir_contents(directory, depth, level=0):
@@ -132,18 +139,33 @@ def get_extension_modules():
     include_dirs = [str(INCLUDE_DIR)]
     LOGGER.info(f"in function `get_extension_modules`; `include_dirs` = {include_dirs}")
 
+    define_args = ["-D__DEBUG_PRINT__"] if debug_print else []
+    if usdt_probes:
+        define_args.append("-D__PYNT_USDT__")
+
     module_newtypemethod = Extension(
         "newtype.extensions.newtypemethod",
-        sources=["newtype/extensions/newtype_meth.c"],
+        sources=[
+            "newtype/extensions/newtype_meth.c",
+            "newtype/extensions/newtype_stats.c",
+            "newtype/extensions/newtype_trace.c",
+        ],
         include_dirs=["newtype/extensions"],
-        extra_compile_args=["-D__DEBUG_PRINT__"] if debug_print else [],
+        extra_compile_args=define_args,
     )
 
     module_newtypeinit = Extension(
         "newtype.extensions.newtypeinit",
-        sources=["newtype/extensions/newtype_init.c"],
+        sources=[
+            "newtype/extensions/newtype_init.c",
+            "newtype/extensions/newtype_validator.c",
+            "newtype/extensions/newtype_freelist.c",
+            "newtype/extensions/newtype_allocs.c",
+            "newtype/extensions/newtype_stats.c",
+            "newtype/extensions/newtype_trace.c",
+        ],
         include_dirs=["newtype/extensions"],
-        extra_compile_args=["-D__DEBUG_PRINT__"] if debug_print else [],
+        extra_compile_args=define_args,
     )
 
     extensions = [
@@ -166,6 +188,40 @@ def copy_output_to_cmd_buildlib(cmd):
         LOGGER.info("File copied successfully")
 
 
+def build_native_harness(cmd):
+    """Builds the native benchmark harness, an executable embedding the interpreter.
+
+    It is linked against the shared or static libpython of the running interpreter,
+    with the compiler `build_ext` has set up, into `build/harness/`.
+    """
+    source = "benchmarks/native/newtype_harness.c"
+    output_dir = PROJECT_ROOT_DIR / "build" / "harness"
+    libdir = sysconfig.get_config_var("LIBDIR")
+    version = sysconfig.get_config_var("LDVERSION") or sysconfig.get_python_version()
+    link_args = (sysconfig.get_config_var("LINKFORSHARED") or "").split()
+    link_args += (sysconfig.get_config_var("LIBS") or "").split()
+    link_args += (sysconfig.get_config_var("SYSLIBS") or "").split()
+    if libdir:
+        link_args.append(f"-Wl,-rpath,{libdir}")
+
+    objects = cmd.compiler.compile(
+        [source],
+        output_dir=str(output_dir),
+        include_dirs=[sysconfig.get_paths()["include"]],
+        macros=[("NEWTYPE_HARNESS_PYTHON", f'"{sys.executable}"')],
+        extra_postargs=["-O2"],
+    )
+    cmd.compiler.link_executable(
+        objects,
+        "newtype_harness",
+        output_dir=str(output_dir),
+        libraries=[f"python{version}"],
+        library_dirs=[libdir] if libdir else [],
+        extra_postargs=link_args,
+    )
+    LOGGER.info(f"Built the native benchmark harness into `{output_dir}`")
+
+
 def build_c_extensions():
     """Builds the extension modules using pure C without Cython."""
     extensions = get_extension_modules()
@@ -182,6 +238,9 @@ def build_c_extensions():
 
     copy_output_to_cmd_buildlib(cmd)
 
+    if build_harness:
+        build_native_harness(cmd)
+
 
 if __name__ == "__main__":
     # actual build
@@ -34,11 +34,38 @@ The library consists of several key components:
     - NewTypeInit: Handles initialization and validation of new types
     - NewTypeMethod: Ensures proper type preservation in method calls
     - newtype_exclude: Decorator to exclude methods from type wrapping
+    - newtype_invariant: Decorator to rewrap results without re-running `__init__`
+    - raw: Context manager in which methods return unwrapped base-type results
+    - enable_stats, stats, latency, reset_stats: Runtime counters and latency
+      percentiles of the NewType descriptors
+    - enable_trace, trace_dump: Per-thread ring buffers of descriptor events
+    - NewTypeProfiler: A `sys.monitoring` tool timing NewType calls, on 3.12+
+    - FusedChain: Method chain that validates once, when its value escapes
+    - unwrap, unwrap_many: Convert NewType instances to their exact base type
+    - ExactKeyDict: A `dict` storing NewType keys as exact base-type values
+    - NativeValidator: C-implemented validator for `str`/`bytes` values that can
+      validate batches without holding the GIL
 """
 
-from .extensions.newtypeinit import NewTypeInit
+from .extensions.newtypeinit import NativeValidator, NewTypeInit, unwrap, unwrap_many
 from .extensions.newtypemethod import NewTypeMethod
-from .newtype import NewType, func_is_excluded, newtype_exclude
+from .fused import FusedChain
+from .mapping import ExactKeyDict
+from .monitoring import NewTypeProfiler
+from .newtype import (
+    NewType,
+    enable_stats,
+    enable_trace,
+    func_is_excluded,
+    func_is_invariant,
+    latency,
+    newtype_exclude,
+    newtype_invariant,
+    raw,
+    reset_stats,
+    stats,
+    trace_dump,
+)
 
 
 __version__ = "0.0.0"  # Don't manually change, let poetry-dynamic-versioning handle it
@@ -46,7 +73,22 @@ __all__ = [
     "NewType",
     "newtype_exclude",
     "func_is_excluded",
+    "newtype_invariant",
+    "func_is_invariant",
+    "raw",
+    "enable_stats",
+    "stats",
+    "latency",
+    "reset_stats",
+    "enable_trace",
+    "trace_dump",
+    "FusedChain",
+    "unwrap",
+    "unwrap_many",
+    "ExactKeyDict",
+    "NewTypeProfiler",
     "NewTypeInit",
     "NewTypeMethod",
+    "NativeValidator",
     "mypy_plugin",
 ]
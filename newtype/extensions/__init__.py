@@ -3,12 +3,48 @@
 This package contains C extension modules that implement core functionality
 for the python-newtype library:
 
-- newtypeinit: Handles initialization and validation of NewType instances
+- newtypeinit: Handles initialization and validation of NewType instances, including
+  native validators that run without the GIL
 - newtypemethod: Ensures proper type preservation in method calls
 """
 
-from .newtypeinit import NEWTYPE_INIT_ARGS_STR, NEWTYPE_INIT_KWARGS_STR, NewTypeInit
-from .newtypemethod import NewTypeMethod
+from .newtypeinit import (
+    NEWTYPE_FREELIST_STR,
+    NEWTYPE_INIT_ARGS_STR,
+    NEWTYPE_INIT_KWARGS_STR,
+    NEWTYPE_PENDING_STR,
+    NativeValidator,
+    NewTypeInit,
+    construct_many,
+    count_allocations,
+    freelist_stats,
+    instantiate,
+    set_freelist,
+    unsafe_cast,
+    unwrap,
+    unwrap_many,
+    validate_pending,
+)
+from .newtypemethod import NewTypeMethod, raw_enter, raw_exit
 
 
-__all__ = ["NewTypeInit", "NewTypeMethod", "NEWTYPE_INIT_ARGS_STR", "NEWTYPE_INIT_KWARGS_STR"]
+__all__ = [
+    "NewTypeInit",
+    "NewTypeMethod",
+    "NativeValidator",
+    "construct_many",
+    "count_allocations",
+    "set_freelist",
+    "freelist_stats",
+    "instantiate",
+    "unsafe_cast",
+    "unwrap",
+    "unwrap_many",
+    "validate_pending",
+    "raw_enter",
+    "raw_exit",
+    "NEWTYPE_FREELIST_STR",
+    "NEWTYPE_INIT_ARGS_STR",
+    "NEWTYPE_INIT_KWARGS_STR",
+    "NEWTYPE_PENDING_STR",
+]
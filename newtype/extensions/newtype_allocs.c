@@ -0,0 +1,112 @@
+#define PY_SSIZE_T_CLEAN
+#include "newtype_allocs.h"
+
+#include <Python.h>
+
+#include "newtype_debug_print.h"
+
+// The allocators of the domains that hold objects and their buffers, wrapped
+// while counting, as `tracemalloc` does. `PYMEM_DOMAIN_RAW` is left alone: it
+// may be called without the GIL, and the counters are not atomic.
+static const PyMemAllocatorDomain NEWTYPE_ALLOCS_DOMAINS[] = {
+    PYMEM_DOMAIN_MEM, PYMEM_DOMAIN_OBJ};
+#define NEWTYPE_ALLOCS_NDOMAINS \
+  (sizeof(NEWTYPE_ALLOCS_DOMAINS) / sizeof(NEWTYPE_ALLOCS_DOMAINS[0]))
+
+static PyMemAllocatorEx NEWTYPE_ALLOCS_WRAPPED[NEWTYPE_ALLOCS_NDOMAINS];
+static int NEWTYPE_ALLOCS_ACTIVE = 0;
+static unsigned long long NEWTYPE_ALLOCS_ALLOCATED = 0;
+static unsigned long long NEWTYPE_ALLOCS_FREED = 0;
+
+static void* NewTypeAllocs_malloc(void* ctx, size_t size)
+{
+  PyMemAllocatorEx* wrapped = (PyMemAllocatorEx*)ctx;
+  NEWTYPE_ALLOCS_ALLOCATED++;
+  return wrapped->malloc(wrapped->ctx, size);
+}
+
+static void* NewTypeAllocs_calloc(void* ctx, size_t nelem, size_t elsize)
+{
+  PyMemAllocatorEx* wrapped = (PyMemAllocatorEx*)ctx;
+  NEWTYPE_ALLOCS_ALLOCATED++;
+  return wrapped->calloc(wrapped->ctx, nelem, elsize);
+}
+
+static void* NewTypeAllocs_realloc(void* ctx, void* ptr, size_t new_size)
+{
+  PyMemAllocatorEx* wrapped = (PyMemAllocatorEx*)ctx;
+  NEWTYPE_ALLOCS_ALLOCATED++;
+  if (ptr != NULL) {
+    NEWTYPE_ALLOCS_FREED++;  // the block is moved or resized, not added
+  }
+  return wrapped->realloc(wrapped->ctx, ptr, new_size);
+}
+
+static void NewTypeAllocs_free(void* ctx, void* ptr)
+{
+  PyMemAllocatorEx* wrapped = (PyMemAllocatorEx*)ctx;
+  if (ptr != NULL) {
+    NEWTYPE_ALLOCS_FREED++;
+  }
+  wrapped->free(wrapped->ctx, ptr);
+}
+
+// Blocks allocated while counting are freed by the wrapped allocator itself
+// once the hooks are removed, so they can be removed at any time
+static void NewTypeAllocs_hook(int install)
+{
+  size_t i;
+
+  for (i = 0; i < NEWTYPE_ALLOCS_NDOMAINS; i++) {
+    if (install) {
+      PyMemAllocatorEx hook;
+
+      PyMem_GetAllocator(NEWTYPE_ALLOCS_DOMAINS[i], &NEWTYPE_ALLOCS_WRAPPED[i]);
+      hook.ctx = &NEWTYPE_ALLOCS_WRAPPED[i];
+      hook.malloc = NewTypeAllocs_malloc;
+      hook.calloc = NewTypeAllocs_calloc;
+      hook.realloc = NewTypeAllocs_realloc;
+      hook.free = NewTypeAllocs_free;
+      PyMem_SetAllocator(NEWTYPE_ALLOCS_DOMAINS[i], &hook);
+    } else {
+      PyMem_SetAllocator(NEWTYPE_ALLOCS_DOMAINS[i], &NEWTYPE_ALLOCS_WRAPPED[i]);
+    }
+  }
+}
+
+PyObject* NewTypeAllocs_count(PyObject* func, Py_ssize_t number)
+{
+  unsigned long long allocated, freed;
+  Py_ssize_t i;
+  int failed = 0;
+
+  if (NEWTYPE_ALLOCS_ACTIVE) {
+    PyErr_SetString(PyExc_RuntimeError, "allocations are already counted");
+    return NULL;
+  }
+  if (number < 0) {
+    PyErr_SetString(PyExc_ValueError, "`number` must not be negative");
+    return NULL;
+  }
+
+  NEWTYPE_ALLOCS_ACTIVE = 1;
+  NEWTYPE_ALLOCS_ALLOCATED = NEWTYPE_ALLOCS_FREED = 0;
+  NewTypeAllocs_hook(1);
+  for (i = 0; i < number && !failed; i++) {
+    PyObject* result = PyObject_CallObject(func, NULL);
+    if (result == NULL) {
+      failed = 1;
+    }
+    Py_XDECREF(result);
+  }
+  NewTypeAllocs_hook(0);
+  allocated = NEWTYPE_ALLOCS_ALLOCATED;
+  freed = NEWTYPE_ALLOCS_FREED;
+  NEWTYPE_ALLOCS_ACTIVE = 0;
+
+  if (failed) {
+    return NULL;
+  }
+  DEBUG_PRINT("%llu allocations, %llu frees\n", allocated, freed);
+  return Py_BuildValue("KK", allocated, freed);
+}
@@ -0,0 +1,12 @@
+#ifndef NEWTYPE_ALLOCS_H
+#define NEWTYPE_ALLOCS_H
+
+#include <Python.h>
+
+// Calls `func()` `number` times and counts the requests made meanwhile to the
+// `PyMem` and `PyObject` allocators. Returns a new `(allocations, frees)`
+// tuple, where reallocations count as allocations and add no block, or NULL
+// with an exception set if a call fails.
+PyObject* NewTypeAllocs_count(PyObject* func, Py_ssize_t number);
+
+#endif  // NEWTYPE_ALLOCS_H
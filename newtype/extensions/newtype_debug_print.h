@@ -4,6 +4,11 @@
 #define ANSI_COLOR_BLUE    "\x1b[34m"
 #define ANSI_COLOR_RESET   "\x1b[0m"
 
+// Prints each step of the extensions to stderr, in builds made with
+// `make build-debug`. It stays alongside `newtype.enable_trace()` because it
+// shows the values at each step, which the fixed-size trace records cannot
+// hold; the reprs it formats make it a tool for stepping through a single
+// call while developing, not for processes under load.
 #ifdef __DEBUG_PRINT__
 #include <stdio.h>
 #include <stdarg.h>
@@ -0,0 +1,300 @@
+#define PY_SSIZE_T_CLEAN
+#include "newtype_freelist.h"
+
+#include <Python.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "newtype_debug_print.h"
+
+// Deallocated instances of one NewType, kept for its next allocations, like
+// the free-lists CPython keeps for floats and tuples. `items` point at the
+// start of each block, `presize` bytes ahead of the object.
+typedef struct {
+  Py_ssize_t presize;  // the GC header and the managed dict pointers, if any
+  int gc;  // whether the blocks are released with `PyObject_GC_Del`
+  Py_ssize_t capacity;
+  Py_ssize_t size;
+  void** items;
+  unsigned long long hits;  // allocations served from `items`
+  unsigned long long misses;  // allocations that went to the allocator
+  unsigned long long kept;  // deallocations added to `items`
+  unsigned long long released;  // deallocations made while `items` was full
+} NewTypeFreeList;
+
+// Name of the capsules holding a `NewTypeFreeList`
+#define NEWTYPE_FREELIST_CAPSULE "newtype.freelist"
+
+// Interned `NEWTYPE_FREELIST_STR`; set by the first free-list created, before
+// which no type uses the allocator below
+static PyObject* NEWTYPE_FREELIST = NULL;
+
+// Returns the free-list of `type`, held by a capsule in its own `__dict__`,
+// or NULL if it has none. Inherited attributes are not looked at, since a
+// subclass does not use the slots below unless given a free-list of its own.
+// Does not raise, and leaves any exception set.
+static NewTypeFreeList* NewTypeFreeList_find(PyTypeObject* type)
+{
+  PyObject* capsule;
+
+  if (NEWTYPE_FREELIST == NULL || type->tp_dict == NULL) {
+    return NULL;
+  }
+  capsule = PyDict_GetItem(type->tp_dict, NEWTYPE_FREELIST);
+  if (capsule == NULL || !PyCapsule_IsValid(capsule, NEWTYPE_FREELIST_CAPSULE))
+  {
+    return NULL;
+  }
+  return (NewTypeFreeList*)PyCapsule_GetPointer(capsule,
+                                                NEWTYPE_FREELIST_CAPSULE);
+}
+
+// Number of bytes the allocation of an instance of `type` starts ahead of it
+static Py_ssize_t NewTypeFreeList_presize(PyTypeObject* type)
+{
+  Py_ssize_t presize = 0;
+
+  if (PyType_IS_GC(type)) {
+    presize += 2 * sizeof(uintptr_t);  // `PyGC_Head`
+  }
+#if defined(Py_TPFLAGS_MANAGED_WEAKREF)
+  if (PyType_HasFeature(type, Py_TPFLAGS_MANAGED_DICT)
+      || PyType_HasFeature(type, Py_TPFLAGS_MANAGED_WEAKREF))
+  {
+    presize += 2 * sizeof(PyObject*);
+  }
+#elif defined(Py_TPFLAGS_MANAGED_DICT)
+  if (PyType_HasFeature(type, Py_TPFLAGS_MANAGED_DICT)) {
+    presize += 2 * sizeof(PyObject*);
+  }
+#endif
+  return presize;
+}
+
+// Frees a block that was kept by `fl`, or would have been
+static void NewTypeFreeList_release(NewTypeFreeList* fl, void* mem)
+{
+  PyObject* op = (PyObject*)((char*)mem + fl->presize);
+  if (fl->gc) {
+    PyObject_GC_Del(op);
+  } else {
+    PyObject_Del(op);
+  }
+}
+
+static PyObject* NewTypeFreeList_alloc(PyTypeObject* type, Py_ssize_t nitems)
+{
+  NewTypeFreeList* fl = NewTypeFreeList_find(type);
+  PyObject* op;
+  char* mem;
+
+  if (fl == NULL || fl->size == 0) {
+    if (fl != NULL) {
+      fl->misses++;
+    }
+    return PyType_GenericAlloc(type, nitems);
+  }
+  fl->hits++;
+  mem = fl->items[--fl->size];
+
+  // leave the block as `PyType_GenericAlloc` would: zeroed, with an untracked
+  // GC header that has no finalizer recorded as run, and no managed dict
+  memset(mem, 0, fl->presize + type->tp_basicsize);
+  op = (PyObject*)(mem + fl->presize);
+  PyObject_Init(op, type);
+  if (PyType_IS_GC(type)) {
+    PyObject_GC_Track(op);
+  }
+  return op;
+}
+
+// `subtype_dealloc` has already cleared the instance and untracked it, and
+// it only releases its reference to the type afterwards. A type whose
+// `__dict__` was cleared while it still has instances, as the collector does
+// with a class in a reference cycle, no longer finds its free-list here.
+static void NewTypeFreeList_free(void* self)
+{
+  PyTypeObject* type = Py_TYPE((PyObject*)self);
+  NewTypeFreeList* fl = NewTypeFreeList_find(type);
+
+  if (fl == NULL) {
+    if (PyType_IS_GC(type)) {
+      PyObject_GC_Del(self);
+    } else {
+      PyObject_Del(self);
+    }
+    return;
+  }
+  if (fl->size == fl->capacity) {
+    fl->released++;
+    NewTypeFreeList_release(fl, (char*)self - fl->presize);
+    return;
+  }
+  fl->kept++;
+  fl->items[fl->size++] = (char*)self - fl->presize;
+}
+
+// Releases the instances `fl` keeps beyond `capacity`
+static void NewTypeFreeList_trim(NewTypeFreeList* fl, Py_ssize_t capacity)
+{
+  while (fl->size > capacity) {
+    NewTypeFreeList_release(fl, fl->items[--fl->size]);
+  }
+}
+
+// Destructor of the capsule, run when the free-list is removed or the type's
+// `__dict__` is cleared or deallocated; the type's memory is still valid
+// then, and the kept blocks still point at it
+static void NewTypeFreeList_destroy(PyObject* capsule)
+{
+  NewTypeFreeList* fl = (NewTypeFreeList*)PyCapsule_GetPointer(
+      capsule, NEWTYPE_FREELIST_CAPSULE);
+
+  NewTypeFreeList_trim(fl, 0);
+  PyMem_Free(fl->items);
+  PyMem_Free(fl);
+}
+
+static int NewTypeFreeList_check(PyTypeObject* type)
+{
+  if (!PyType_HasFeature(type, Py_TPFLAGS_HEAPTYPE)) {
+    PyErr_Format(PyExc_TypeError,
+                 "cannot give `%s` a free-list: not a heap type",
+                 type->tp_name);
+    return -1;
+  }
+  if (type->tp_itemsize != 0) {
+    PyErr_Format(PyExc_TypeError,
+                 "cannot give `%s` a free-list: its instances vary in size",
+                 type->tp_name);
+    return -1;
+  }
+#ifdef Py_TPFLAGS_INLINE_VALUES
+  if (PyType_HasFeature(type, Py_TPFLAGS_INLINE_VALUES)) {
+    PyErr_Format(PyExc_TypeError,
+                 "cannot give `%s` a free-list: its instances have a "
+                 "`__dict__`, define `__slots__`",
+                 type->tp_name);
+    return -1;
+  }
+#endif
+  if (type->tp_alloc != PyType_GenericAlloc
+      || (type->tp_free != PyObject_GC_Del && type->tp_free != PyObject_Del))
+  {
+    PyErr_Format(PyExc_TypeError,
+                 "cannot give `%s` a free-list: it has its own allocator",
+                 type->tp_name);
+    return -1;
+  }
+  return 0;
+}
+
+// Creates the free-list of `type`, which has none yet
+static int NewTypeFreeList_create(PyTypeObject* type, Py_ssize_t capacity)
+{
+  NewTypeFreeList* fl;
+  PyObject* capsule;
+
+  if (NewTypeFreeList_check(type) < 0) {
+    return -1;
+  }
+  if (NEWTYPE_FREELIST == NULL) {
+    NEWTYPE_FREELIST = PyUnicode_InternFromString(NEWTYPE_FREELIST_STR);
+    if (NEWTYPE_FREELIST == NULL) {
+      return -1;
+    }
+  }
+  fl = PyMem_New(NewTypeFreeList, 1);
+  if (fl == NULL) {
+    PyErr_NoMemory();
+    return -1;
+  }
+  memset(fl, 0, sizeof(*fl));
+  fl->items = PyMem_New(void*, capacity);
+  if (fl->items == NULL) {
+    PyMem_Free(fl);
+    PyErr_NoMemory();
+    return -1;
+  }
+  fl->presize = NewTypeFreeList_presize(type);
+  fl->gc = PyType_IS_GC(type);
+  fl->capacity = capacity;
+  capsule =
+      PyCapsule_New(fl, NEWTYPE_FREELIST_CAPSULE, NewTypeFreeList_destroy);
+  if (capsule == NULL) {
+    PyMem_Free(fl->items);
+    PyMem_Free(fl);
+    return -1;
+  }
+  // the type holds the free-list, and not the other way round, so that the
+  // kept blocks are released with the type
+  if (PyDict_SetItem(type->tp_dict, NEWTYPE_FREELIST, capsule) < 0) {
+    Py_DECREF(capsule);
+    return -1;
+  }
+  Py_DECREF(capsule);
+  type->tp_alloc = NewTypeFreeList_alloc;
+  type->tp_free = NewTypeFreeList_free;
+  PyType_Modified(type);
+  DEBUG_PRINT("free-list of %zd for `%s`\n", capacity, type->tp_name);
+  return 0;
+}
+
+int NewTypeFreeList_set(PyTypeObject* type, Py_ssize_t capacity)
+{
+  NewTypeFreeList* fl = NewTypeFreeList_find(type);
+  void** items;
+
+  if (capacity < 0) {
+    PyErr_SetString(PyExc_ValueError, "`capacity` must not be negative");
+    return -1;
+  }
+
+  if (fl == NULL) {
+    return capacity == 0 ? 0 : NewTypeFreeList_create(type, capacity);
+  }
+
+  if (capacity == 0) {
+    type->tp_alloc = PyType_GenericAlloc;
+    type->tp_free = fl->gc ? PyObject_GC_Del : PyObject_Del;
+    PyType_Modified(type);
+    // releases the kept instances, through the capsule's destructor
+    return PyDict_DelItem(type->tp_dict, NEWTYPE_FREELIST);
+  }
+  NewTypeFreeList_trim(fl, capacity);
+  items = fl->items;
+  if (PyMem_Resize(items, void*, capacity) == NULL) {
+    PyErr_NoMemory();
+    return -1;
+  }
+  fl->items = items;
+  fl->capacity = capacity;
+  return 0;
+}
+
+PyObject* NewTypeFreeList_stats(PyTypeObject* type)
+{
+  NewTypeFreeList* fl = NewTypeFreeList_find(type);
+  unsigned long long allocs;
+
+  if (fl == NULL) {
+    Py_RETURN_NONE;
+  }
+  allocs = fl->hits + fl->misses;
+  return Py_BuildValue("{s:n,s:n,s:K,s:K,s:K,s:K,s:d}",
+                       "capacity",
+                       fl->capacity,
+                       "size",
+                       fl->size,
+                       "hits",
+                       fl->hits,
+                       "misses",
+                       fl->misses,
+                       "kept",
+                       fl->kept,
+                       "released",
+                       fl->released,
+                       "hit_rate",
+                       allocs ? (double)fl->hits / (double)allocs : 0.0);
+}
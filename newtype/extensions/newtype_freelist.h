@@ -0,0 +1,20 @@
+#ifndef NEWTYPE_FREELIST_H
+#define NEWTYPE_FREELIST_H
+
+#include <Python.h>
+
+// Name under which a type keeps its free-list, in its own `__dict__`, so that
+// subclasses do not share it and it is released with the type
+#define NEWTYPE_FREELIST_STR "_newtype_freelist_"
+
+// Gives `type`, a heap type whose instances all have the same size, a
+// free-list keeping up to `capacity` deallocated instances for reuse by its
+// `tp_alloc`; a `capacity` of 0 removes it and releases the instances kept.
+// Sets an exception and returns -1 on failure.
+int NewTypeFreeList_set(PyTypeObject* type, Py_ssize_t capacity);
+
+// Returns a new dict of the counters of the free-list of `type`, or a new
+// reference to None if it has none
+PyObject* NewTypeFreeList_stats(PyTypeObject* type);
+
+#endif  // NEWTYPE_FREELIST_H
@@ -4,17 +4,69 @@
 #include <Python.h>
 #include <stddef.h>
 
+#include "newtype_allocs.h"
 #include "newtype_debug_print.h"
+#include "newtype_freelist.h"
 #include "newtype_meth.h"
+#include "newtype_probes.h"
+#include "newtype_trace.h"
+#include "newtype_validator.h"
 #include "structmember.h"
 
+// Interned "__init__", used to find the `NewTypeInit` of a class
+static PyObject* NEWTYPE_INIT_DUNDER_INIT = NULL;
+// Interned `NEWTYPE_PENDING_STR`
+static PyObject* NEWTYPE_PENDING = NULL;
+// Interned `NEWTYPE_INIT_FILLS_STR`
+static PyObject* NEWTYPE_INIT_FILLS = NULL;
+// Interned `NEWTYPE_BASE_STR` and "__new__", used by `unsafe_cast`
+static PyObject* NEWTYPE_BASE = NULL;
+static PyObject* NEWTYPE_INIT_DUNDER_NEW = NULL;
+static PyObject* NEWTYPE_INIT_DUNDER_SLOTS = NULL;
+static PyObject* NEWTYPE_INIT_DICT = NULL;
+static PyObject* NEWTYPE_INIT_ARGS = NULL;
+static PyObject* NEWTYPE_INIT_KWARGS = NULL;
+// Interned names used by `instantiate`
+static PyObject* NEWTYPE_PARAMS = NULL;
+static PyObject* NEWTYPE_ARGS = NULL;
+static PyObject* NEWTYPE_INSTANCES = NULL;
+static PyObject* NEWTYPE_INIT_MODULE = NULL;
+static PyObject* NEWTYPE_INIT_QUALNAME = NULL;
+
+// Set at import, under `python -X dev` or when `NEWTYPE_CHECK_UNSAFE_CAST` is
+// set in the environment; `unsafe_cast` then fully constructs its result
+static int NEWTYPE_CHECK_UNSAFE_CAST = 0;
+
+// Flags for `NewTypeInit_invoke`
+#define NEWTYPE_INIT_EAGER 0x1  // validate now even if the class is lazy
+
+// The value `construct_many` is constructing on this thread, and the validator
+// that already validated it, so that `NewTypeInit_invoke` does not validate it
+// again; validators and `str`/`bytes` values are immutable. Both are borrowed
+// from `construct_many` for the duration of the call.
+static NEWTYPE_THREAD_LOCAL PyObject* NEWTYPE_INIT_PREVALIDATED = NULL;
+static NEWTYPE_THREAD_LOCAL PyObject* NEWTYPE_INIT_PREVALIDATOR = NULL;
+
 static int NewTypeInit_init(NewTypeInitObject* self,
                             PyObject* args,
                             PyObject* kwds)
 {
+  static char* kwlist[] = {"func", "validator", "lazy", "pool", NULL};
   PyObject* func;
+  PyObject* validator = Py_None;
+  PyObject* pool = Py_None;
+  int lazy = 0;
+
+  if (!PyArg_ParseTupleAndKeywords(
+          args, kwds, "O|O$pO", kwlist, &func, &validator, &lazy, &pool))
+  {
+    return -1;
+  }
 
-  if (!PyArg_ParseTuple(args, "O", &func)) {
+  if (validator != Py_None && !NativeValidator_Check(validator)) {
+    PyErr_Format(PyExc_TypeError,
+                 "`validator` must be a `NativeValidator` or `None`, got `%s`",
+                 Py_TYPE(validator)->tp_name);
     return -1;
   }
 
@@ -23,6 +75,7 @@ static int NewTypeInit_init(NewTypeInitObject* self,
     self->has_get = 1;
   } else {
     self->func_get = func;
+    Py_INCREF(self->func_get);
     self->has_get = 0;
   }
 
@@ -30,6 +83,16 @@ static int NewTypeInit_init(NewTypeInitObject* self,
     return -1;
   }
 
+  if (validator != Py_None) {
+    Py_INCREF(validator);
+    Py_XSETREF(self->validator, (NativeValidatorObject*)validator);
+  }
+  self->lazy = lazy;
+  if (pool != Py_None) {
+    Py_INCREF(pool);
+    Py_XSETREF(self->pool, pool);
+  }
+
   // Print initial values
   DEBUG_PRINT("NewTypeInit_init: `self->obj`: %s\n",
               PyUnicode_AsUTF8(PyObject_Repr(self->obj)));
@@ -43,8 +106,8 @@ static PyObject* NewTypeInit_get(NewTypeInitObject* self,
                                  PyObject* inst,
                                  PyObject* owner)
 {
-  Py_XDECREF(self->obj);  // Decrease reference to old object
-  Py_XDECREF(self->cls);  // Decrease reference to old class
+  PyObject* old_obj = self->obj;
+  PyTypeObject* old_cls = self->cls;
   DEBUG_PRINT("NewTypeInit_get is called\n");
 
   // Check current values
@@ -57,6 +120,10 @@ static PyObject* NewTypeInit_get(NewTypeInitObject* self,
   Py_XINCREF(self->obj);
   self->cls = (PyTypeObject*)owner;
   Py_XINCREF(self->cls);
+  // released last, as deallocating them may run code that reaches `self`,
+  // the garbage collector included
+  Py_XDECREF(old_obj);
+  Py_XDECREF(old_cls);
 
   // Print new values
   DEBUG_PRINT("NewTypeInit_get updated: `self->obj`: %s\n",
@@ -86,23 +153,207 @@ static PyObject* NewTypeInit_get(NewTypeInitObject* self,
   return (PyObject*)self;
 }
 
-static PyObject* NewTypeInit_call(NewTypeInitObject* self,
-                                  PyObject* args,
-                                  PyObject* kwds)
+// Returns 1 if `obj` has the attribute `name`, 0 if not. An empty slot is read
+// directly, as looking it up would raise and format an `AttributeError` only
+// to discard it.
+static int NewTypeInit_has_attr(PyObject* obj, PyObject* name)
 {
-  DEBUG_PRINT("NewTypeInit_call is called\n");
+  PyObject* descr = _PyType_Lookup(Py_TYPE(obj), name);
 
-  DEBUG_PRINT("NewTypeInit_call: `self->obj`: %s\n",
-              PyUnicode_AsUTF8(PyObject_Repr(self->obj)));
-  DEBUG_PRINT("NewTypeInit_call: `self->cls`: %s\n",
-              PyUnicode_AsUTF8(PyObject_Repr((PyObject*)self->cls)));
+  if (descr != NULL && Py_TYPE(descr) == &PyMemberDescr_Type) {
+    PyMemberDef* member = ((PyMemberDescrObject*)descr)->d_member;
+    if (member->type == T_OBJECT_EX) {
+      return *(PyObject**)((char*)obj + member->offset) != NULL;
+    }
+  }
+  return PyObject_HasAttr(obj, name);
+}
+
+// Records the arguments other than the value on `obj` so that rewraps in
+// `NewTypeMethod_call` can pass them back in; only the first call records
+static int NewTypeInit_record_args(PyObject* obj,
+                                   PyObject* args,
+                                   PyObject* kwds)
+{
+  if (NewTypeInit_has_attr(obj, NEWTYPE_INIT_ARGS) != 1) {
+    DEBUG_PRINT("Setting `%s` attribute on `%s` to `%s`\n",
+                NEWTYPE_INIT_ARGS_STR,
+                PyUnicode_AsUTF8(PyObject_Repr(obj)),
+                PyUnicode_AsUTF8(PyObject_Repr(args)));
+    PyObject* args_slice;
+    if (PyTuple_GET_SIZE(args) > 1) {
+      args_slice = PyTuple_GetSlice(args, 1, PyTuple_GET_SIZE(args));
+    } else {
+      args_slice = PyTuple_New(0);
+    }
+    if (args_slice == NULL) {
+      return -1;
+    }
+    if (PyObject_SetAttr(obj, NEWTYPE_INIT_ARGS, args_slice) < 0) {
+      Py_DECREF(args_slice);
+      return -1;
+    }
+    Py_DECREF(args_slice);
+  }
+
+  if (NewTypeInit_has_attr(obj, NEWTYPE_INIT_KWARGS) != 1) {
+    DEBUG_PRINT("Setting `%s` attribute on `%s` to `%s`\n",
+                NEWTYPE_INIT_KWARGS_STR,
+                PyUnicode_AsUTF8(PyObject_Repr(obj)),
+                PyUnicode_AsUTF8(PyObject_Repr(kwds)));
+    PyObject* kwds_record;
+    if (kwds == NULL) {  // `kwds` is `NULL`, first time the constructor is
+                         // called, so we make a new `dict`.
+      kwds_record = PyDict_New();
+    } else {  // `kwds` is borrowed here, so we increase its ref count
+      kwds_record = kwds;
+      Py_INCREF(kwds_record);
+    }
+    if (kwds_record == NULL) {
+      return -1;
+    }
+    if (PyObject_SetAttr(obj, NEWTYPE_INIT_KWARGS, kwds_record) < 0)
+    {
+      Py_DECREF(kwds_record);
+      return -1;
+    }
+    Py_DECREF(kwds_record);
+  }
+  return 0;
+}
+
+static PyTypeObject* NewTypeInit_find_base_newtype(PyTypeObject* cls);
+
+// Makes `obj`, just initialised from `args`, the canonical instance of `cls`
+// for its value; only values of the exact base type are pooled, as those are
+// the only ones `BaseNewType.__new__` looks up
+static int NewTypeInit_intern(NewTypeInitObject* self,
+                              PyObject* obj,
+                              PyTypeObject* cls,
+                              PyObject* args,
+                              PyObject* kwds)
+{
+  PyTypeObject* base_newtype;
+  PyObject* base;
+
+  if (obj == NULL || PyTuple_GET_SIZE(args) != 1
+      || (kwds != NULL && PyDict_GET_SIZE(kwds) > 0))
+  {
+    return 0;
+  }
+  base_newtype = NewTypeInit_find_base_newtype(cls);
+  if (base_newtype == NULL) {
+    return PyErr_Occurred() ? -1 : 0;
+  }
+  base = PyDict_GetItemWithError(base_newtype->tp_dict, NEWTYPE_BASE);
+  if (base == NULL || (PyObject*)Py_TYPE(PyTuple_GET_ITEM(args, 0)) != base) {
+    return PyErr_Occurred() ? -1 : 0;
+  }
+  DEBUG_PRINT("interning `obj`\n");
+  return PyObject_SetItem(self->pool, PyTuple_GET_ITEM(args, 0), obj);
+}
+
+// Fires `newtype:init_validate`, or `newtype:init_fail` with the type of the
+// exception set, for a validation of a `cls` instance that began at `start`
+static inline void NewTypeInit_probe_validated(PyTypeObject* cls,
+                                               unsigned long long start,
+                                               int ok)
+{
+  unsigned long long ns;
+  PyObject* exc;
+  if (!NEWTYPE_PROBE_ENABLED(init_validate)
+      && !NEWTYPE_PROBE_ENABLED(init_fail))
+  {
+    return;
+  }
+  ns = start != 0 ? NewTypeStats_now() - start : 0;
+  if (ok) {
+    NEWTYPE_PROBE2(init_validate, NewTypeProbe_type_name(cls), ns);
+  } else {
+    exc = PyErr_Occurred();
+    NEWTYPE_PROBE3(init_fail,
+                   NewTypeProbe_type_name(cls),
+                   ns,
+                   exc != NULL && PyType_Check(exc)
+                       ? ((PyTypeObject*)exc)->tp_name
+                       : "?");
+  }
+}
+
+// The number of items of `obj` if it is a list, dict or set, or -1
+static Py_ssize_t NewTypeInit_container_size(PyObject* obj)
+{
+  if (PyList_Check(obj)) {
+    return PyList_GET_SIZE(obj);
+  }
+  if (PyDict_Check(obj)) {
+    return PyDict_GET_SIZE(obj);
+  }
+  if (PyAnySet_Check(obj)) {
+    return PySet_GET_SIZE(obj);
+  }
+  return -1;
+}
+
+// Notes that the `__init__` of `type` fills the container instances that
+// `__new__` leaves empty, so that rewraps leave that to it rather than put the
+// contents in first, only for `__init__` to replace them
+static int NewTypeInit_note_fills(PyTypeObject* type)
+{
+  if (PyDict_GetItemWithError(type->tp_dict, NEWTYPE_INIT_FILLS) != NULL) {
+    return 0;
+  }
+  if (PyErr_Occurred()) {
+    return -1;
+  }
+  return PyObject_SetAttr((PyObject*)type, NEWTYPE_INIT_FILLS, Py_True);
+}
 
-  PyObject* result;  // return this
+// Calls the wrapped constructor on `obj`; unlike `NewTypeInit_call` the
+// receiver is explicit so that C callers need not go through `__get__`
+static PyObject* NewTypeInit_invoke(NewTypeInitObject* self,
+                                    PyObject* obj,
+                                    PyTypeObject* cls,
+                                    PyObject* args,
+                                    PyObject* kwds,
+                                    int flags)
+{
+  PyObject* result = NULL;
   PyObject* func;
+  unsigned long long probe_start = 0, latency_start;
+  Py_ssize_t size_before;
+
+  DEBUG_PRINT("NewTypeInit_invoke: `obj`: %s\n",
+              PyUnicode_AsUTF8(PyObject_Repr(obj)));
+  DEBUG_PRINT("NewTypeInit_invoke: `cls`: %s\n",
+              PyUnicode_AsUTF8(PyObject_Repr((PyObject*)cls)));
 
+  NEWTYPE_STATS_ADD(self->stats, calls, 1);
+  NEWTYPE_TRACE(NEWTYPE_TRACE_INIT_CALL, cls);
+
+  // `__new__` of an interned class hands out instances that were initialised
+  // already, which is all that the init records being set can mean here
+  if (self->pool != NULL && obj != NULL && !(flags & NEWTYPE_INIT_EAGER)) {
+    int r = _PyObject_LookupAttr(obj, NEWTYPE_INIT_ARGS, &result);
+    if (r != 0) {
+      Py_XDECREF(result);
+      if (r < 0) {
+        return NULL;
+      }
+      NEWTYPE_STATS_ADD(self->stats, fast_path, 1);
+      NEWTYPE_TRACE(NEWTYPE_TRACE_INIT_SKIP, cls);
+      Py_RETURN_NONE;
+    }
+  }
+
+  if (self->func_get == NULL) {
+    // cleared by the garbage collector while breaking a cycle
+    PyErr_SetString(PyExc_TypeError, "`NewTypeInit` object has no function");
+    return NULL;
+  }
   if (self->has_get) {
     DEBUG_PRINT("`self->has_get`: %d\n", self->has_get);
-    if (self->obj == NULL && self->cls == NULL) {
+    if (obj == NULL && cls == NULL) {
       // free standing function
       PyErr_SetString(
           PyExc_TypeError,
@@ -110,114 +361,196 @@ static PyObject* NewTypeInit_call(NewTypeInitObject* self,
           "`cls` (internal attribute),"
           "it cannot be used to wrap a free standing function");
       return NULL;  // allocated nothing so no need to free
-    } else if (self->obj == NULL) {
-      func = PyObject_CallFunctionObjArgs(
-          self->func_get, Py_None, self->cls, NULL);
-    } else {
-      func = PyObject_CallFunctionObjArgs(
-          self->func_get, self->obj, self->cls, NULL);
     }
+    func = PyObject_CallFunctionObjArgs(
+        self->func_get, obj != NULL ? obj : Py_None, cls, NULL);
   } else {
     DEBUG_PRINT("`self->func_get`: %s\n",
                 PyUnicode_AsUTF8(PyObject_Repr(self->func_get)));
     func = self->func_get;
+    Py_INCREF(func);
   }
 
   if (func == NULL) {
     DEBUG_PRINT("`func` is NULL\n");
-    result = NULL;
-    goto done;
+    return NULL;
   }
 
-  if (self->obj
-      && (PyObject_HasAttrString(self->obj, NEWTYPE_INIT_ARGS_STR) != 1))
-  {
-    DEBUG_PRINT("Setting `%s` attribute on `%s` to `%s`\n",
-                NEWTYPE_INIT_ARGS_STR,
-                PyUnicode_AsUTF8(PyObject_Repr(self->obj)),
-                PyUnicode_AsUTF8(PyObject_Repr(args)));
-    PyObject* args_slice;
-    if (PyTuple_Size(args) > 1) {
-      args_slice = PyTuple_GetSlice(args, 1, PyTuple_Size(args));
-      if (args_slice == NULL) {
-        // Py_DECREF(args_tuple);
-        return NULL;
-      }
-    } else {
-      args_slice = PyTuple_New(0);
+  // Lazy classes only keep the arguments, in a single `(args, kwargs)`
+  // record; `NewTypeInit_validate_pending` records them as an eager
+  // construction would when it runs the validation on first use
+  if (self->lazy && obj != NULL && !(flags & NEWTYPE_INIT_EAGER)) {
+    PyObject* pending = PyTuple_Pack(2, args, kwds != NULL ? kwds : Py_None);
+    int r;
+    if (pending == NULL) {
+      goto done;
     }
-    if (PyObject_SetAttrString(self->obj, NEWTYPE_INIT_ARGS_STR, args_slice)
-        < 0) {
-      Py_DECREF(args_slice);
-      result = NULL;
+    r = PyObject_SetAttr(obj, NEWTYPE_PENDING, pending);
+    Py_DECREF(pending);
+    if (r < 0) {
       goto done;
     }
-    Py_XDECREF(args_slice);
+    NEWTYPE_STATS_ADD(self->stats, fast_path, 1);
+    NEWTYPE_TRACE(NEWTYPE_TRACE_INIT_DEFER, cls);
+    Py_INCREF(Py_None);
+    result = Py_None;
+    goto done;
   }
 
-  if (self->obj
-      && (PyObject_HasAttrString(self->obj, NEWTYPE_INIT_KWARGS_STR) != 1))
-  {
-    DEBUG_PRINT("Setting `%s` attribute on `%s` to `%s`\n",
-                NEWTYPE_INIT_ARGS_STR,
-                PyUnicode_AsUTF8(PyObject_Repr(self->obj)),
-                PyUnicode_AsUTF8(PyObject_Repr(kwds)));
-    if (kwds == NULL) {  // `kwds` is `NULL`, first time the constructor is
-                         // called, so we make a new `dict`.
-      kwds = PyDict_New();
-    } else {  // `kwds` is borrowed here, so we increase its ref count
-      Py_INCREF(kwds);
-    }
-    if (PyObject_SetAttrString(self->obj, NEWTYPE_INIT_KWARGS_STR, kwds) < 0) {
-      result = NULL;
-      goto done;
-    }
+  if (obj != NULL && NewTypeInit_record_args(obj, args, kwds) < 0) {
+    goto done;
   }
 
   DEBUG_PRINT("`args`: %s\n", PyUnicode_AsUTF8(PyObject_Repr(args)));
   DEBUG_PRINT("`kwds`: %s\n", PyUnicode_AsUTF8(PyObject_Repr(kwds)));
 
-  // Ensure `self->cls` is a valid type object
-  if (self->cls && PyType_Check(self->cls)) {
-    result = PyObject_Call(func, args, kwds);
-  } else {
+  // Ensure `cls` is a valid type object
+  if (cls == NULL || !PyType_Check(cls)) {
     PyErr_SetString(PyExc_TypeError, "Invalid type object in descriptor");
-    DEBUG_PRINT("`self->cls` is not a valid type object\n");
-    result = NULL;
+    DEBUG_PRINT("`cls` is not a valid type object\n");
+    goto done;
   }
 
-  if (PyErr_Occurred()) {
-    // Py_DECREF(args_tuple);
+  // The native validator runs before the user's `__init__`, which can then
+  // rely on its checks having passed
+  NEWTYPE_STATS_ADD(self->stats, validations, 1);
+  if (NEWTYPE_PROBE_ENABLED(init_validate) || NEWTYPE_PROBE_ENABLED(init_fail))
+  {
+    probe_start = NewTypeStats_now();
+  }
+  latency_start = NEWTYPE_STATS_START();
+  if (self->validator != NULL && PyTuple_GET_SIZE(args) > 0
+      && !(PyTuple_GET_ITEM(args, 0) == NEWTYPE_INIT_PREVALIDATED
+           && (PyObject*)self->validator == NEWTYPE_INIT_PREVALIDATOR)
+      && NativeValidator_validate(self->validator, PyTuple_GET_ITEM(args, 0))
+          < 0)
+  {
+    NEWTYPE_STATS_ADD(self->stats, validation_failures, 1);
+    NEWTYPE_STATS_LATENCY(self->stats, latency_start);
+    NEWTYPE_TRACE(NEWTYPE_TRACE_VALIDATE_FAIL, cls);
+    NewTypeInit_probe_validated(cls, probe_start, 0);
     goto done;
   }
 
+  size_before = obj != NULL ? NewTypeInit_container_size(obj) : -1;
+  result = PyObject_Call(func, args, kwds);
+  NEWTYPE_STATS_LATENCY(self->stats, latency_start);
+  if (result != NULL && size_before == 0
+      && NewTypeInit_container_size(obj) > 0
+      && NewTypeInit_note_fills(Py_TYPE(obj)) < 0)
+  {
+    Py_CLEAR(result);
+  }
+  NewTypeInit_probe_validated(cls, probe_start, result != NULL);
+  NEWTYPE_TRACE(
+      result != NULL ? NEWTYPE_TRACE_VALIDATE : NEWTYPE_TRACE_VALIDATE_FAIL,
+      cls);
+  if (result == NULL) {
+    NEWTYPE_STATS_ADD(self->stats, validation_failures, 1);
+  } else if (self->pool != NULL
+             && NewTypeInit_intern(self, obj, cls, args, kwds) < 0)
+  {
+    Py_CLEAR(result);
+  }
+
 done:
-  Py_XDECREF(func);
-  Py_XDECREF(kwds);
+  Py_DECREF(func);
   DEBUG_PRINT("`result`: %s\n", PyUnicode_AsUTF8(PyObject_Repr(result)));
   return result;
 }
 
-static void NewTypeInit_dealloc(NewTypeInitObject* self)
+static PyObject* NewTypeInit_call(NewTypeInitObject* self,
+                                  PyObject* args,
+                                  PyObject* kwds)
+{
+  DEBUG_PRINT("NewTypeInit_call is called\n");
+  return NewTypeInit_invoke(self, self->obj, self->cls, args, kwds, 0);
+}
+
+// A class refers to its `NewTypeInit` through `__init__`, which refers back
+// to the class and the last instance it was bound to; the garbage collector
+// must see these references to free classes that are no longer used
+static int NewTypeInit_traverse(NewTypeInitObject* self,
+                                visitproc visit,
+                                void* arg)
+{
+  Py_VISIT(self->func_get);
+  Py_VISIT(self->obj);
+  Py_VISIT(self->cls);
+  Py_VISIT(self->validator);
+  Py_VISIT(self->pool);
+  return 0;
+}
+
+static int NewTypeInit_clear(NewTypeInitObject* self)
 {
-  Py_XDECREF(self->cls);
-  Py_XDECREF(self->obj);
-  Py_XDECREF(self->func_get);
+  Py_CLEAR(self->func_get);
+  Py_CLEAR(self->obj);
+  Py_CLEAR(self->cls);
+  Py_CLEAR(self->validator);
+  Py_CLEAR(self->pool);
+  return 0;
+}
 
+static void NewTypeInit_dealloc(NewTypeInitObject* self)
+{
+  PyObject_GC_UnTrack(self);
+  if (self->weakreflist != NULL) {
+    PyObject_ClearWeakRefs((PyObject*)self);
+  }
+  NewTypeInit_clear(self);
+  NewTypeStats_clear(&self->stats);
   Py_TYPE(self)->tp_free((PyObject*)self);
 }
 
-static PyMethodDef NewTypeInit_methods[] = {{NULL, NULL, 0, NULL}};
+static PyObject* NewTypeInit_stats(NewTypeInitObject* self,
+                                   PyObject* Py_UNUSED(ignored))
+{
+  return NewTypeStats_as_dict(&self->stats);
+}
+
+static PyObject* NewTypeInit_latency(NewTypeInitObject* self,
+                                     PyObject* Py_UNUSED(ignored))
+{
+  return NewTypeStats_latency(&self->stats);
+}
+
+static PyObject* NewTypeInit_reset_stats(NewTypeInitObject* self,
+                                         PyObject* Py_UNUSED(ignored))
+{
+  NewTypeStats_reset(&self->stats);
+  Py_RETURN_NONE;
+}
+
+static PyMethodDef NewTypeInit_methods[] = {
+    {"stats",
+     (PyCFunction)NewTypeInit_stats,
+     METH_NOARGS,
+     "Return the counters of the constructor, kept while statistics are "
+     "enabled."},
+    {"latency",
+     (PyCFunction)NewTypeInit_latency,
+     METH_NOARGS,
+     "Return the histogram of the latencies of the validations of the "
+     "constructor, as `(lower ns, upper ns, count)` tuples."},
+    {"reset_stats",
+     (PyCFunction)NewTypeInit_reset_stats,
+     METH_NOARGS,
+     "Set the counters of the constructor back to zero."},
+    {NULL, NULL, 0, NULL}};
 
 static PyTypeObject NewTypeInitType = {
     PyVarObject_HEAD_INIT(NULL, 0).tp_name = "newtypeinit.NewTypeInit",
     .tp_doc = "Descriptor class that wraps methods for instantiating subtypes.",
     .tp_basicsize = sizeof(NewTypeInitObject),
     .tp_itemsize = 0,
-    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC,
     .tp_new = PyType_GenericNew,
     .tp_init = (initproc)NewTypeInit_init,
     .tp_dealloc = (destructor)NewTypeInit_dealloc,
+    .tp_traverse = (traverseproc)NewTypeInit_traverse,
+    .tp_clear = (inquiry)NewTypeInit_clear,
+    .tp_weaklistoffset = offsetof(NewTypeInitObject, weakreflist),
     .tp_call = (ternaryfunc)NewTypeInit_call,
     .tp_getattro = PyObject_GenericGetAttr,
     .tp_setattro = NULL,
@@ -225,18 +558,917 @@ static PyTypeObject NewTypeInitType = {
     .tp_descr_get = (descrgetfunc)NewTypeInit_get,
 };
 
+// Calls `cls(value)`, telling `NewTypeInit_invoke` that `validator` already
+// validated `value`, if not NULL; the marks of an outer call are restored
+static PyObject* NewTypeInit_construct_validated(PyTypeObject* cls,
+                                                 PyObject* value,
+                                                 PyObject* validator)
+{
+  PyObject* saved_value = NEWTYPE_INIT_PREVALIDATED;
+  PyObject* saved_validator = NEWTYPE_INIT_PREVALIDATOR;
+  PyObject* inst;
+
+  NEWTYPE_INIT_PREVALIDATED = validator != NULL ? value : NULL;
+  NEWTYPE_INIT_PREVALIDATOR = validator;
+  inst = PyObject_CallFunctionObjArgs((PyObject*)cls, value, NULL);
+  NEWTYPE_INIT_PREVALIDATED = saved_value;
+  NEWTYPE_INIT_PREVALIDATOR = saved_validator;
+  return inst;
+}
+
+static PyObject* newtypeinit_construct_many(PyObject* module,
+                                           PyObject* args,
+                                           PyObject* kwds)
+{
+  static char* kwlist[] = {"cls", "values", "workers", NULL};
+  PyTypeObject* cls;
+  PyObject *values, *seq, *init, *result;
+  PyObject* validator = NULL;
+  Py_ssize_t workers = 1;
+  Py_ssize_t n, i;
+
+  if (!PyArg_ParseTupleAndKeywords(args,
+                                   kwds,
+                                   "O!O|n",
+                                   kwlist,
+                                   &PyType_Type,
+                                   &cls,
+                                   &values,
+                                   &workers))
+  {
+    return NULL;
+  }
+
+  seq = PySequence_Tuple(values);
+  if (seq == NULL) {
+    return NULL;
+  }
+  n = PyTuple_GET_SIZE(seq);
+
+  // Validate everything up front with the GIL released; instances are then
+  // constructed here on the calling thread, through the metaclass as usual,
+  // without re-running the kernel. Lazy classes are left to validate on
+  // first use, as usual.
+  init = _PyType_Lookup(cls, NEWTYPE_INIT_DUNDER_INIT);  // borrowed
+  if (init != NULL && PyObject_TypeCheck(init, &NewTypeInitType)
+      && ((NewTypeInitObject*)init)->validator != NULL
+      && !((NewTypeInitObject*)init)->lazy)
+  {
+    validator = (PyObject*)((NewTypeInitObject*)init)->validator;
+    Py_INCREF(validator);
+    if (NativeValidator_validate_many(
+            (NativeValidatorObject*)validator, seq, workers)
+        < 0)
+    {
+      Py_DECREF(validator);
+      Py_DECREF(seq);
+      return NULL;
+    }
+  }
+
+  result = PyList_New(n);
+  if (result == NULL) {
+    goto error;
+  }
+  for (i = 0; i < n; i++) {
+    PyObject* inst = NewTypeInit_construct_validated(
+        cls, PyTuple_GET_ITEM(seq, i), validator);
+    if (inst == NULL) {
+      goto error;
+    }
+    PyList_SET_ITEM(result, i, inst);
+  }
+
+  Py_XDECREF(validator);
+  Py_DECREF(seq);
+  return result;
+
+error:
+  Py_XDECREF(result);
+  Py_XDECREF(validator);
+  Py_DECREF(seq);
+  return NULL;
+}
+
+// Runs the validation deferred by a lazy class, if `inst` still has any;
+// returns 1 if it ran, 0 if there was nothing to do and -1 on error, in
+// which case `inst` stays pending so that the next use fails the same way
+static int NewTypeInit_validate_pending(PyObject* inst)
+{
+  PyObject *pending, *init, *args, *kwargs;
+  PyObject* res = NULL;
+  int r;
+
+  r = _PyObject_LookupAttr(inst, NEWTYPE_PENDING, &pending);
+  if (r <= 0) {
+    return r;
+  }
+
+  init = _PyType_Lookup(Py_TYPE(inst), NEWTYPE_INIT_DUNDER_INIT);  // borrowed
+  if (init == NULL || !PyObject_TypeCheck(init, &NewTypeInitType)) {
+    PyErr_Format(PyExc_TypeError,
+                 "`%s.__init__` is not a `NewTypeInit`",
+                 Py_TYPE(inst)->tp_name);
+    Py_DECREF(pending);
+    return -1;
+  }
+  if (!PyTuple_Check(pending) || PyTuple_GET_SIZE(pending) != 2
+      || !PyTuple_Check(PyTuple_GET_ITEM(pending, 0)))
+  {
+    PyErr_SetString(PyExc_TypeError, "corrupted `" NEWTYPE_PENDING_STR "`");
+    Py_DECREF(pending);
+    return -1;
+  }
+  Py_INCREF(init);
+  args = PyTuple_GET_ITEM(pending, 0);
+  kwargs = PyTuple_GET_ITEM(pending, 1);
+
+  // Cleared before running the validation, so that methods called on `inst`
+  // from the user's `__init__` do not recurse into here
+  if (PyObject_SetAttr(inst, NEWTYPE_PENDING, NULL) < 0) {
+    goto done;
+  }
+  res = NewTypeInit_invoke((NewTypeInitObject*)init,
+                           inst,
+                           Py_TYPE(inst),
+                           args,
+                           PyDict_Check(kwargs) ? kwargs : NULL,
+                           NEWTYPE_INIT_EAGER);
+  if (res == NULL) {
+    PyObject *type, *value, *traceback;
+    PyErr_Fetch(&type, &value, &traceback);
+    if (PyObject_SetAttr(inst, NEWTYPE_PENDING, pending) < 0) {
+      PyErr_Clear();
+    }
+    PyErr_Restore(type, value, traceback);
+  }
+
+done:
+  Py_XDECREF(res);
+  Py_DECREF(init);
+  Py_DECREF(pending);
+  return res == NULL ? -1 : 1;
+}
+
+static PyObject* newtypeinit_validate_pending(PyObject* module, PyObject* inst)
+{
+  if (NewTypeInit_validate_pending(inst) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+// Finds the `BaseNewType` that `cls` derives from; borrowed, NULL if none
+static PyTypeObject* NewTypeInit_find_base_newtype(PyTypeObject* cls)
+{
+  PyObject* mro = cls->tp_mro;
+  if (mro == NULL) {
+    return NULL;
+  }
+  for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(mro); i++) {
+    PyTypeObject* t = (PyTypeObject*)PyTuple_GET_ITEM(mro, i);
+    if (PyType_HasFeature(t, Py_TPFLAGS_HEAPTYPE) && t->tp_dict != NULL
+        && PyDict_GetItemWithError(t->tp_dict, NEWTYPE_BASE) != NULL)
+    {
+      return t;
+    }
+  }
+  return NULL;
+}
+
+// Whether `key` names one of the per-instance records, which must not be
+// copied along when the value is itself a NewType instance
+static int NewTypeInit_is_record(PyObject* key)
+{
+  if (!PyUnicode_Check(key)) {
+    return 0;
+  }
+  return PyUnicode_Compare(key, NEWTYPE_INIT_ARGS) == 0
+         || PyUnicode_Compare(key, NEWTYPE_INIT_KWARGS) == 0
+         || PyUnicode_Compare(key, NEWTYPE_PENDING) == 0;
+}
+
+// Copies the attributes of `value` to `inst`, as `BaseNewType.__new__` does
+// for `object` bases. The `__dict__` is copied one attribute at a time, in
+// insertion order, so that the dict of `inst` is built on the keys its class
+// shares among its instances (PEP 412) instead of becoming a table of its own.
+static int NewTypeInit_copy_attributes(PyObject* inst, PyObject* value)
+{
+  PyObject *value_dict, *value_slots, *key, *item;
+  Py_ssize_t pos = 0;
+  int r;
+
+  r = _PyObject_LookupAttr(value, NEWTYPE_INIT_DICT, &value_dict);
+  if (r < 0) {
+    return -1;
+  }
+  if (r > 0 && PyDict_Check(value_dict)) {
+    r = 0;
+    while (r == 0 && PyDict_Next(value_dict, &pos, &key, &item)) {
+      if (!NewTypeInit_is_record(key)) {
+        // `PyDict_Next` hands out borrowed references
+        Py_INCREF(key);
+        Py_INCREF(item);
+        r = PyObject_GenericSetAttr(inst, key, item);
+        Py_DECREF(item);
+        Py_DECREF(key);
+      }
+    }
+    if (r < 0) {
+      Py_DECREF(value_dict);
+      return -1;
+    }
+  }
+  Py_XDECREF(value_dict);
+
+  r = _PyObject_LookupAttr(value, NEWTYPE_INIT_DUNDER_SLOTS, &value_slots);
+  if (r <= 0) {
+    return r;
+  }
+  if (PyUnicode_Check(value_slots)) {
+    r = _PyObject_LookupAttr(value, value_slots, &item);
+    if (r > 0) {
+      r = PyObject_SetAttr(inst, value_slots, item);
+      Py_DECREF(item);
+    }
+  } else {
+    PyObject* it = PyObject_GetIter(value_slots);
+    r = it == NULL ? -1 : 0;
+    while (r >= 0 && (key = PyIter_Next(it)) != NULL) {
+      r = _PyObject_LookupAttr(value, key, &item);
+      if (r > 0) {
+        r = PyObject_SetAttr(inst, key, item);
+        Py_DECREF(item);
+      }
+      Py_DECREF(key);
+    }
+    Py_XDECREF(it);
+    if (PyErr_Occurred()) {
+      r = -1;
+    }
+  }
+  Py_DECREF(value_slots);
+  return r < 0 ? -1 : 0;
+}
+
+// Builds an instance of `cls` around `value` without running `__init__` or
+// any validator; see `BaseNewType.unsafe_cast`
+static PyObject* newtypeinit_unsafe_cast(PyObject* module,
+                                         PyObject* const* args,
+                                         Py_ssize_t nargs)
+{
+  PyTypeObject *cls, *base_newtype, *base;
+  PyObject *value, *inst, *value_args, *kwds_record, *base_new;
+
+  if (nargs != 2) {
+    PyErr_Format(PyExc_TypeError,
+                 "unsafe_cast() takes exactly 2 arguments (%zd given)",
+                 nargs);
+    return NULL;
+  }
+  if (!PyType_Check(args[0])) {
+    PyErr_SetString(PyExc_TypeError, "`cls` must be a type");
+    return NULL;
+  }
+  cls = (PyTypeObject*)args[0];
+  value = args[1];
+
+  if (Py_TYPE(value) == cls) {
+    Py_INCREF(value);
+    return value;
+  }
+  if (NEWTYPE_CHECK_UNSAFE_CAST) {
+    return PyObject_CallFunctionObjArgs((PyObject*)cls, value, NULL);
+  }
+
+  base_newtype = NewTypeInit_find_base_newtype(cls);
+  if (base_newtype == NULL) {
+    if (!PyErr_Occurred()) {
+      PyErr_Format(PyExc_TypeError, "`%s` is not a NewType", cls->tp_name);
+    }
+    return NULL;
+  }
+  base = (PyTypeObject*)PyDict_GetItemWithError(base_newtype->tp_dict,
+                                                NEWTYPE_BASE);  // borrowed
+  if (base == NULL || !PyType_Check(base)) {
+    if (!PyErr_Occurred()) {
+      PyErr_Format(PyExc_TypeError,
+                   "`%s." NEWTYPE_BASE_STR "` is not a type",
+                   base_newtype->tp_name);
+    }
+    return NULL;
+  }
+
+  value_args = PyTuple_Pack(1, value);
+  if (value_args == NULL) {
+    return NULL;
+  }
+  base_new = PyDict_GetItemWithError(base_newtype->tp_dict,
+                                    NEWTYPE_INIT_DUNDER_NEW);  // borrowed
+  if (_PyType_Lookup(cls, NEWTYPE_INIT_DUNDER_NEW) != base_new) {
+    // only `__init__` is skipped when a subclass customises `__new__`
+    inst = PyErr_Occurred() ? NULL : cls->tp_new(cls, value_args, NULL);
+  } else if (base->tp_new == PyBaseObject_Type.tp_new) {
+    PyObject* empty = PyTuple_New(0);
+    inst = empty == NULL ? NULL : base->tp_new(cls, empty, NULL);
+    Py_XDECREF(empty);
+    if (inst != NULL && NewTypeInit_copy_attributes(inst, value) < 0) {
+      Py_CLEAR(inst);
+    }
+  } else {
+    // what `BaseNewType.__new__` does, minus the Python frame
+    inst = base->tp_new(cls, value_args, NULL);
+  }
+  Py_DECREF(value_args);
+  if (inst == NULL || !PyObject_TypeCheck(inst, cls)) {
+    return inst;
+  }
+
+  // the same records as a construction without extra arguments would leave
+  kwds_record = PyDict_New();
+  if (kwds_record == NULL) {
+    Py_DECREF(inst);
+    return NULL;
+  }
+  value_args = PyTuple_New(0);
+  if (value_args == NULL
+      || PyObject_SetAttr(inst, NEWTYPE_INIT_ARGS, value_args) < 0
+      || PyObject_SetAttr(inst, NEWTYPE_INIT_KWARGS, kwds_record) < 0)
+  {
+    Py_XDECREF(value_args);
+    Py_DECREF(kwds_record);
+    Py_DECREF(inst);
+    return NULL;
+  }
+  Py_DECREF(value_args);
+  Py_DECREF(kwds_record);
+  return inst;
+}
+
+// Returns a new reference to an instance of the exact base type of `value`
+// with the same contents: `value` itself if it is one already, otherwise a
+// copy made without going through any (wrapped) method of `value`'s type, or
+// for a base with a `__new__` of its own, built by calling the base on `value`
+static PyObject* NewTypeInit_unwrap(PyObject* value)
+{
+  PyTypeObject *type = Py_TYPE(value), *base_newtype, *base;
+  PyObject* inst;
+
+  if (PyUnicode_CheckExact(value) || PyLong_CheckExact(value)
+      || PyFloat_CheckExact(value) || PyBytes_CheckExact(value)
+      || PyTuple_CheckExact(value) || PyFrozenSet_CheckExact(value))
+  {
+    Py_INCREF(value);
+    return value;
+  }
+  if (PyUnicode_Check(value)) {
+    return PyUnicode_Substring(value, 0, PyUnicode_GET_LENGTH(value));
+  }
+  if (PyBool_Check(value)) {
+    Py_INCREF(value);
+    return value;
+  }
+  if (PyLong_Check(value)) {
+    return PyLong_Type.tp_as_number->nb_int(value);
+  }
+  if (PyFloat_Check(value)) {
+    return PyFloat_FromDouble(PyFloat_AS_DOUBLE(value));
+  }
+  if (PyBytes_Check(value)) {
+    return PyBytes_FromStringAndSize(PyBytes_AS_STRING(value),
+                                     PyBytes_GET_SIZE(value));
+  }
+  if (PyTuple_Check(value)) {
+    return PyTuple_GetSlice(value, 0, PyTuple_GET_SIZE(value));
+  }
+  if (PyFrozenSet_Check(value)) {
+    return PyFrozenSet_New(value);
+  }
+
+  // Mutable values cannot be shared with the NewType instance, so they are
+  // always copied, shallowly, as the NewType constructors do
+  if (PyList_Check(value)) {
+    return PyList_GetSlice(value, 0, PyList_GET_SIZE(value));
+  }
+  if (PyDict_Check(value)) {
+    return PyDict_Copy(value);
+  }
+  if (PyAnySet_Check(value)) {
+    return PySet_New(value);
+  }
+
+  // NewTypes of other classes built with `object.__new__`
+  base_newtype = NewTypeInit_find_base_newtype(type);
+  if (base_newtype == NULL) {
+    if (PyErr_Occurred()) {
+      return NULL;
+    }
+    Py_INCREF(value);
+    return value;
+  }
+  base = (PyTypeObject*)PyDict_GetItemWithError(base_newtype->tp_dict,
+                                                NEWTYPE_BASE);  // borrowed
+  if (base == NULL || !PyType_Check(base)) {
+    if (PyErr_Occurred()) {
+      return NULL;
+    }
+    Py_INCREF(value);
+    return value;
+  }
+  if (base->tp_new != PyBaseObject_Type.tp_new) {
+    // only the base knows how its instances are made, so it is left to build
+    // one from `value`, as a copy constructor would
+    inst = PyObject_CallFunctionObjArgs((PyObject*)base, value, NULL);
+    if (inst != NULL && Py_TYPE(inst) != base) {
+      PyErr_Format(PyExc_TypeError,
+                   "cannot unwrap `%s`: `%s(value)` returned `%s`, not `%s`",
+                   type->tp_name,
+                   base->tp_name,
+                   Py_TYPE(inst)->tp_name,
+                   base->tp_name);
+      Py_CLEAR(inst);
+    }
+    return inst;
+  }
+  inst = PyTuple_New(0);
+  if (inst == NULL) {
+    return NULL;
+  }
+  Py_SETREF(inst, base->tp_new(base, inst, NULL));
+  if (inst != NULL && NewTypeInit_copy_attributes(inst, value) < 0) {
+    Py_CLEAR(inst);
+  }
+  return inst;
+}
+
+static PyObject* newtypeinit_unwrap(PyObject* module, PyObject* value)
+{
+  return NewTypeInit_unwrap(value);
+}
+
+static PyObject* newtypeinit_unwrap_many(PyObject* module, PyObject* values)
+{
+  PyObject *seq, *result;
+  Py_ssize_t n;
+
+  seq = PySequence_Fast(values, "`values` must be iterable");
+  if (seq == NULL) {
+    return NULL;
+  }
+  n = PySequence_Fast_GET_SIZE(seq);
+  result = PyList_New(n);
+  if (result == NULL) {
+    Py_DECREF(seq);
+    return NULL;
+  }
+  for (Py_ssize_t i = 0; i < n; i++) {
+    PyObject* item = NewTypeInit_unwrap(PySequence_Fast_GET_ITEM(seq, i));
+    if (item == NULL) {
+      Py_DECREF(result);
+      Py_DECREF(seq);
+      return NULL;
+    }
+    PyList_SET_ITEM(result, i, item);
+  }
+  Py_DECREF(seq);
+  return result;
+}
+
+static PyObject* newtypeinit_set_freelist(PyObject* module,
+                                          PyObject* const* args,
+                                          Py_ssize_t nargs)
+{
+  Py_ssize_t capacity;
+
+  if (nargs != 2) {
+    PyErr_Format(PyExc_TypeError,
+                 "set_freelist() takes exactly 2 arguments (%zd given)",
+                 nargs);
+    return NULL;
+  }
+  if (!PyType_Check(args[0])) {
+    PyErr_SetString(PyExc_TypeError, "`cls` must be a type");
+    return NULL;
+  }
+  capacity = PyNumber_AsSsize_t(args[1], PyExc_OverflowError);
+  if (capacity == -1 && PyErr_Occurred()) {
+    return NULL;
+  }
+  if (NewTypeFreeList_set((PyTypeObject*)args[0], capacity) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+static PyObject* newtypeinit_freelist_stats(PyObject* module, PyObject* cls)
+{
+  if (!PyType_Check(cls)) {
+    PyErr_SetString(PyExc_TypeError, "`cls` must be a type");
+    return NULL;
+  }
+  return NewTypeFreeList_stats((PyTypeObject*)cls);
+}
+
+static PyObject* newtypeinit_count_allocations(PyObject* module,
+                                               PyObject* const* args,
+                                               Py_ssize_t nargs)
+{
+  Py_ssize_t number = 1;
+
+  if (nargs < 1 || nargs > 2) {
+    PyErr_Format(PyExc_TypeError,
+                 "count_allocations() takes 1 or 2 arguments (%zd given)",
+                 nargs);
+    return NULL;
+  }
+  if (!PyCallable_Check(args[0])) {
+    PyErr_SetString(PyExc_TypeError, "`func` must be callable");
+    return NULL;
+  }
+  if (nargs == 2) {
+    number = PyNumber_AsSsize_t(args[1], PyExc_OverflowError);
+    if (number == -1 && PyErr_Occurred()) {
+      return NULL;
+    }
+  }
+  return NewTypeAllocs_count(args[0], number);
+}
+
+// Returns the class referred to by `ref`, a new reference, or NULL without
+// an exception set if it is gone
+static PyObject* NewTypeInit_deref(PyObject* ref)
+{
+#if PY_VERSION_HEX >= 0x030D0000
+  PyObject* obj;
+  return PyWeakref_GetRef(ref, &obj) > 0 ? obj : NULL;
+#else
+  PyObject* obj = PyWeakref_GetObject(ref);  // borrowed
+  if (obj == NULL || obj == Py_None) {
+    return NULL;
+  }
+  Py_INCREF(obj);
+  return obj;
+#endif
+}
+
+// Removes the entries of the classes that are gone from `instances`, each
+// time it doubles in size, so that sweeping costs O(1) per instantiation
+static int NewTypeInit_sweep_instances(PyObject* instances)
+{
+  Py_ssize_t size = PyDict_GET_SIZE(instances), pos = 0;
+  PyObject *key, *ref, *dead;
+
+  if (size < 64 || (size & (size - 1)) != 0) {
+    return 0;
+  }
+  dead = PyList_New(0);
+  if (dead == NULL) {
+    return -1;
+  }
+  while (PyDict_Next(instances, &pos, &key, &ref)) {
+    PyObject* obj = NewTypeInit_deref(ref);
+    if (obj != NULL) {
+      Py_DECREF(obj);
+    } else if (PyErr_Occurred() || PyList_Append(dead, key) < 0) {
+      Py_DECREF(dead);
+      return -1;
+    }
+  }
+  for (pos = 0; pos < PyList_GET_SIZE(dead); pos++) {
+    if (PyDict_DelItem(instances, PyList_GET_ITEM(dead, pos)) < 0) {
+      Py_DECREF(dead);
+      return -1;
+    }
+  }
+  Py_DECREF(dead);
+  return 0;
+}
+
+// Creates the class `cls[args]`: a subclass that only sets each parameter
+// of `cls` to its argument. It adds no slots and no methods, so it shares
+// the layout and the method descriptors of `cls`, and `BaseNewType` does not
+// wrap the methods of the base type again for it.
+static PyObject* NewTypeInit_new_instantiation(PyTypeObject* cls,
+                                               PyObject* args)
+{
+  PyObject *params, *ns, *reprs = NULL, *sep = NULL, *joined = NULL;
+  PyObject *qualname = NULL, *module, *result = NULL;
+  Py_ssize_t i, n = PyTuple_GET_SIZE(args);
+
+  if (PyDict_GetItemWithError(cls->tp_dict, NEWTYPE_ARGS) != NULL) {
+    PyErr_Format(
+        PyExc_TypeError, "`%s` is already parameterised", cls->tp_name);
+    return NULL;
+  }
+  if (PyErr_Occurred()
+      || _PyObject_LookupAttr((PyObject*)cls, NEWTYPE_PARAMS, &params) < 0)
+  {
+    return NULL;
+  }
+  if (params == NULL || !PyTuple_Check(params)) {
+    PyErr_Format(
+        PyExc_TypeError, "`%s` is not a parameterised NewType", cls->tp_name);
+    Py_XDECREF(params);
+    return NULL;
+  }
+  if (PyTuple_GET_SIZE(params) != n) {
+    PyErr_Format(PyExc_TypeError,
+                 "`%s` takes %zd parameter(s) %R, got %zd",
+                 cls->tp_name,
+                 PyTuple_GET_SIZE(params),
+                 params,
+                 n);
+    Py_DECREF(params);
+    return NULL;
+  }
+
+  ns = PyDict_New();
+  if (ns == NULL) {
+    Py_DECREF(params);
+    return NULL;
+  }
+  for (i = 0; i < n; i++) {
+    if (PyDict_SetItem(ns,
+                       PyTuple_GET_ITEM(params, i),
+                       PyTuple_GET_ITEM(args, i))
+        < 0)
+    {
+      goto done;
+    }
+  }
+
+  reprs = PyTuple_New(n);
+  if (reprs == NULL) {
+    goto done;
+  }
+  for (i = 0; i < n; i++) {
+    PyObject* r = PyObject_Repr(PyTuple_GET_ITEM(args, i));
+    if (r == NULL) {
+      goto done;
+    }
+    PyTuple_SET_ITEM(reprs, i, r);
+  }
+  sep = PyUnicode_FromString(", ");
+  joined = sep == NULL ? NULL : PyUnicode_Join(sep, reprs);
+  if (joined == NULL) {
+    goto done;
+  }
+  qualname = PyObject_GetAttr((PyObject*)cls, NEWTYPE_INIT_QUALNAME);
+  module = qualname == NULL
+               ? NULL
+               : PyDict_GetItemWithError(cls->tp_dict, NEWTYPE_INIT_MODULE);
+  if (module == NULL) {
+    goto done;
+  }
+  Py_SETREF(qualname, PyUnicode_FromFormat("%U[%U]", qualname, joined));
+  if (qualname == NULL
+      || PyDict_SetItem(ns, NEWTYPE_INIT_QUALNAME, qualname) < 0
+      || PyDict_SetItem(ns, NEWTYPE_INIT_MODULE, module) < 0
+      || PyDict_SetItem(ns, NEWTYPE_ARGS, args) < 0)
+  {
+    goto done;
+  }
+  {
+    PyObject* no_slots = PyTuple_New(0);
+    int r = no_slots == NULL
+                ? -1
+                : PyDict_SetItem(ns, NEWTYPE_INIT_DUNDER_SLOTS, no_slots);
+    Py_XDECREF(no_slots);
+    if (r < 0) {
+      goto done;
+    }
+  }
+
+  result = PyObject_CallFunction(
+      (PyObject*)Py_TYPE(cls), "O(O)O", qualname, (PyObject*)cls, ns);
+
+done:
+  Py_DECREF(params);
+  Py_DECREF(ns);
+  Py_XDECREF(reprs);
+  Py_XDECREF(sep);
+  Py_XDECREF(joined);
+  Py_XDECREF(qualname);
+  return result;
+}
+
+// `cls[args]` for a parameterised NewType `cls`. Instantiations are made once
+// per arguments and kept in a table on `cls`, by weak reference, so that the
+// classes no longer used can be freed.
+static PyObject* newtypeinit_instantiate(PyObject* module,
+                                         PyObject* const* args,
+                                         Py_ssize_t nargs)
+{
+  PyTypeObject* cls;
+  PyObject *key, *instances, *ref, *result;
+
+  if (nargs != 2) {
+    PyErr_Format(PyExc_TypeError,
+                 "instantiate() takes exactly 2 arguments (%zd given)",
+                 nargs);
+    return NULL;
+  }
+  if (!PyType_Check(args[0])) {
+    PyErr_SetString(PyExc_TypeError, "`cls` must be a type");
+    return NULL;
+  }
+  cls = (PyTypeObject*)args[0];
+
+  instances = PyDict_GetItemWithError(cls->tp_dict, NEWTYPE_INSTANCES);
+  if (instances != NULL && PyDict_CheckExact(instances)) {
+    ref = PyDict_GetItemWithError(instances, args[1]);
+    if (ref != NULL && (result = NewTypeInit_deref(ref)) != NULL) {
+      return result;
+    }
+  }
+  if (PyErr_Occurred()) {
+    return NULL;
+  }
+
+  key = PyTuple_Check(args[1]) ? args[1] : PyTuple_Pack(1, args[1]);
+  if (key == NULL) {
+    return NULL;
+  }
+  if (key == args[1]) {
+    Py_INCREF(key);
+  }
+  result = NewTypeInit_new_instantiation(cls, key);
+  Py_DECREF(key);
+  if (result == NULL) {
+    return NULL;
+  }
+
+  instances = PyDict_GetItemWithError(cls->tp_dict, NEWTYPE_INSTANCES);
+  if (instances == NULL || !PyDict_CheckExact(instances)) {
+    int r;
+    if (PyErr_Occurred() || (instances = PyDict_New()) == NULL) {
+      Py_DECREF(result);
+      return NULL;
+    }
+    r = PyObject_SetAttr((PyObject*)cls, NEWTYPE_INSTANCES, instances);
+    Py_DECREF(instances);  // `cls` holds it now
+    if (r < 0) {
+      Py_DECREF(result);
+      return NULL;
+    }
+  }
+  ref = PyWeakref_NewRef(result, NULL);
+  if (ref == NULL || PyDict_SetItem(instances, args[1], ref) < 0
+      || NewTypeInit_sweep_instances(instances) < 0)
+  {
+    Py_XDECREF(ref);
+    Py_DECREF(result);
+    return NULL;
+  }
+  Py_DECREF(ref);
+  return result;
+}
+
+static PyMethodDef newtypeinit_module_methods[] = {
+    {"unwrap",
+     (PyCFunction)newtypeinit_unwrap,
+     METH_O,
+     "unwrap(value)\n--\n\n"
+     "Return `value` as an instance of its exact base type, such as `str` for "
+     "a `NewType(str)` instance; exact instances are returned as they are."},
+    {"unwrap_many",
+     (PyCFunction)newtypeinit_unwrap_many,
+     METH_O,
+     "unwrap_many(values)\n--\n\n"
+     "Return a list with every value unwrapped as by `unwrap`."},
+    {"unsafe_cast",
+     (PyCFunction)(void (*)(void))newtypeinit_unsafe_cast,
+     METH_FASTCALL,
+     "unsafe_cast(cls, value)\n--\n\n"
+     "Build an instance of `cls` around an already-valid `value`, running "
+     "neither its native validator nor `__init__`. Validates anyway under "
+     "`python -X dev` or with `NEWTYPE_CHECK_UNSAFE_CAST` set."},
+    {"set_freelist",
+     (PyCFunction)(void (*)(void))newtypeinit_set_freelist,
+     METH_FASTCALL,
+     "set_freelist(cls, capacity)\n--\n\n"
+     "Keep up to `capacity` deallocated instances of `cls` for reuse by its "
+     "next allocations; a `capacity` of 0 releases them and stops keeping "
+     "any. `cls` must be a class whose instances all have the same size."},
+    {"freelist_stats",
+     (PyCFunction)newtypeinit_freelist_stats,
+     METH_O,
+     "freelist_stats(cls)\n--\n\n"
+     "Return the counters of the free-list of `cls`: its `capacity` and "
+     "`size`, the allocations served from it (`hits`) or not (`misses`), "
+     "the deallocations it `kept` or `released`, and the `hit_rate`; or "
+     "None if `cls` has no free-list."},
+    {"set_stats_enabled",
+     (PyCFunction)NewTypeStats_set_enabled,
+     METH_O,
+     "Make the `NewTypeInit`s keep counters or not; returns whether they did."},
+    {"set_latency_enabled",
+     (PyCFunction)NewTypeStats_set_latency_enabled,
+     METH_O,
+     "Make the `NewTypeInit`s record the latencies of validations or not; "
+     "returns whether they did."},
+    {"set_trace_enabled",
+     (PyCFunction)NewTypeTrace_set_enabled,
+     METH_O,
+     "Make the `NewTypeInit`s record trace events or not; returns whether "
+     "they did."},
+    {"trace_records",
+     (PyCFunction)NewTypeTrace_records,
+     METH_NOARGS,
+     "Return the trace records of the `NewTypeInit`s, as `(thread id, ns, "
+     "event, type address)` tuples."},
+    {"trace_clear",
+     (PyCFunction)NewTypeTrace_clear,
+     METH_NOARGS,
+     "Drop the trace records of the `NewTypeInit`s."},
+    {"count_allocations",
+     (PyCFunction)(void (*)(void))newtypeinit_count_allocations,
+     METH_FASTCALL,
+     "count_allocations(func, number=1)\n--\n\n"
+     "Call `func()` `number` times and return the number of requests to the "
+     "object and memory allocators meanwhile, as `(allocations, frees)`."},
+    {"instantiate",
+     (PyCFunction)(void (*)(void))newtypeinit_instantiate,
+     METH_FASTCALL,
+     "instantiate(cls, args)\n--\n\n"
+     "Return `cls[args]` for a parameterised NewType `cls`: the subclass "
+     "setting each parameter of `cls` to its argument, created once per "
+     "`args`."},
+    {"validate_pending",
+     (PyCFunction)newtypeinit_validate_pending,
+     METH_O,
+     "Run the validation deferred by a lazy NewType on `inst`, if any."},
+    {"construct_many",
+     (PyCFunction)(void (*)(void))newtypeinit_construct_many,
+     METH_VARARGS | METH_KEYWORDS,
+     "Construct an instance of `cls` for every value; if `cls` has a native "
+     "validator, all values are validated first on up to `workers` threads "
+     "with the GIL released."},
+    {NULL, NULL, 0, NULL}};
+
 static struct PyModuleDef NewTypeInitmodule = {
     PyModuleDef_HEAD_INIT,
     .m_name = "newtypeinit",
     .m_doc = "A module containing `NewTypeInit` descriptor class.",
     .m_size = -1,
-    .m_methods = NewTypeInit_methods,
+    .m_methods = newtypeinit_module_methods,
 };
 
 PyMODINIT_FUNC PyInit_newtypeinit(void)
 {
   if (PyType_Ready(&NewTypeInitType) < 0)
     return NULL;
+  if (PyType_Ready(&NativeValidatorType) < 0)
+    return NULL;
+
+  if (NEWTYPE_INIT_DUNDER_INIT == NULL) {
+    NEWTYPE_INIT_DUNDER_INIT = PyUnicode_InternFromString("__init__");
+    if (NEWTYPE_INIT_DUNDER_INIT == NULL)
+      return NULL;
+  }
+  if (NEWTYPE_PENDING == NULL) {
+    NEWTYPE_PENDING = PyUnicode_InternFromString(NEWTYPE_PENDING_STR);
+    NEWTYPE_INIT_FILLS = PyUnicode_InternFromString(NEWTYPE_INIT_FILLS_STR);
+    if (NEWTYPE_PENDING == NULL || NEWTYPE_INIT_FILLS == NULL)
+      return NULL;
+  }
+  if (NEWTYPE_BASE == NULL) {
+    NEWTYPE_BASE = PyUnicode_InternFromString(NEWTYPE_BASE_STR);
+    NEWTYPE_INIT_DUNDER_NEW = PyUnicode_InternFromString("__new__");
+    NEWTYPE_INIT_DICT = PyUnicode_InternFromString("__dict__");
+    NEWTYPE_INIT_DUNDER_SLOTS = PyUnicode_InternFromString("__slots__");
+    NEWTYPE_INIT_ARGS = PyUnicode_InternFromString(NEWTYPE_INIT_ARGS_STR);
+    NEWTYPE_INIT_KWARGS = PyUnicode_InternFromString(NEWTYPE_INIT_KWARGS_STR);
+    if (NEWTYPE_BASE == NULL || NEWTYPE_INIT_DUNDER_NEW == NULL
+        || NEWTYPE_INIT_DICT == NULL || NEWTYPE_INIT_DUNDER_SLOTS == NULL
+        || NEWTYPE_INIT_ARGS == NULL || NEWTYPE_INIT_KWARGS == NULL)
+      return NULL;
+  }
+  if (NEWTYPE_PARAMS == NULL) {
+    NEWTYPE_PARAMS = PyUnicode_InternFromString(NEWTYPE_PARAMS_STR);
+    NEWTYPE_ARGS = PyUnicode_InternFromString(NEWTYPE_ARGS_STR);
+    NEWTYPE_INSTANCES = PyUnicode_InternFromString(NEWTYPE_INSTANCES_STR);
+    NEWTYPE_INIT_MODULE = PyUnicode_InternFromString("__module__");
+    NEWTYPE_INIT_QUALNAME = PyUnicode_InternFromString("__qualname__");
+    if (NEWTYPE_PARAMS == NULL || NEWTYPE_ARGS == NULL
+        || NEWTYPE_INSTANCES == NULL || NEWTYPE_INIT_MODULE == NULL
+        || NEWTYPE_INIT_QUALNAME == NULL)
+      return NULL;
+  }
+
+  {
+    PyObject* flags = PySys_GetObject("flags");  // borrowed
+    PyObject* dev_mode =
+        flags != NULL ? PyObject_GetAttrString(flags, "dev_mode") : NULL;
+    const char* env = getenv("NEWTYPE_CHECK_UNSAFE_CAST");
+    if (dev_mode == NULL) {
+      PyErr_Clear();
+    }
+    NEWTYPE_CHECK_UNSAFE_CAST =
+        (dev_mode != NULL && PyObject_IsTrue(dev_mode) > 0)
+        || (env != NULL && env[0] != '\0');
+    Py_XDECREF(dev_mode);
+  }
 
   PyObject* m = PyModule_Create(&NewTypeInitmodule);
   if (m == NULL)
@@ -271,6 +1503,27 @@ PyMODINIT_FUNC PyInit_newtypeinit(void)
     return NULL;
   }
 
+  PyObject* PY_NEWTYPE_FREELIST_STR =
+      PyUnicode_FromString(NEWTYPE_FREELIST_STR);
+  if (PY_NEWTYPE_FREELIST_STR == NULL) {
+    Py_DECREF(m);
+    return NULL;
+  }
+  if (PyModule_AddObject(m, "NEWTYPE_FREELIST_STR", PY_NEWTYPE_FREELIST_STR)
+      < 0)
+  {
+    Py_DECREF(PY_NEWTYPE_FREELIST_STR);
+    Py_DECREF(m);
+    return NULL;
+  }
+
+  Py_INCREF(NEWTYPE_PENDING);
+  if (PyModule_AddObject(m, "NEWTYPE_PENDING_STR", NEWTYPE_PENDING) < 0) {
+    Py_DECREF(NEWTYPE_PENDING);
+    Py_DECREF(m);
+    return NULL;
+  }
+
   Py_INCREF(&NewTypeInitType);
   if (PyModule_AddObject(m, "NewTypeInit", (PyObject*)&NewTypeInitType) < 0) {
     Py_DECREF(&NewTypeInitType);
@@ -278,5 +1531,14 @@ PyMODINIT_FUNC PyInit_newtypeinit(void)
     return NULL;
   }
 
+  Py_INCREF(&NativeValidatorType);
+  if (PyModule_AddObject(m, "NativeValidator", (PyObject*)&NativeValidatorType)
+      < 0)
+  {
+    Py_DECREF(&NativeValidatorType);
+    Py_DECREF(m);
+    return NULL;
+  }
+
   return m;
 }
@@ -3,9 +3,33 @@
 
 #include <Python.h>
 
+#include "newtype_stats.h"
+#include "newtype_validator.h"
+
 // Constants for initialization arguments
 #define NEWTYPE_INIT_ARGS_STR "_newtype_init_args_"
 #define NEWTYPE_INIT_KWARGS_STR "_newtype_init_kwargs_"
+// Class attribute of a `BaseNewType` holding the type it wraps
+#define NEWTYPE_BASE_STR "_newtype_base_"
+// Holds the `(args, kwargs)` an instance was constructed with, for as long as
+// its validation is deferred
+#define NEWTYPE_PENDING_STR "_newtype_pending_"
+// Class attributes of parameterised NewTypes: the names of the parameters of
+// a generic class, the arguments of one of its instantiations, and the table
+// of its instantiations
+#define NEWTYPE_PARAMS_STR "_newtype_params_"
+#define NEWTYPE_ARGS_STR "_newtype_args_"
+#define NEWTYPE_INSTANCES_STR "_newtype_instances_"
+// Class attribute of a `BaseNewType` subclass, false if constructing it never
+// looks at the value given to `__init__`
+#define NEWTYPE_INIT_READS_VALUE_STR "_newtype_init_reads_value_"
+// Set in the dict of a list, dict or set NewType once its `__init__` has been
+// seen to fill an instance that `__new__` left empty
+#define NEWTYPE_INIT_FILLS_STR "_newtype_init_fills_"
+
+#if PY_VERSION_HEX >= 0x030D0000
+#  define _PyObject_LookupAttr PyObject_GetOptionalAttr
+#endif
 
 // Structure definition for NewTypeInitObject
 typedef struct {
@@ -13,6 +37,11 @@ typedef struct {
   int has_get;
   PyObject *obj;
   PyTypeObject *cls;
+  NativeValidatorObject *validator;
+  int lazy;
+  PyObject *pool;  // canonical instances by base value, for interned classes
+  PyObject *weakreflist;
+  NewTypeStats stats;
 } NewTypeInitObject;
 
 // Module initialization function
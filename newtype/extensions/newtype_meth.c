@@ -6,8 +6,49 @@
 #include <stddef.h>
 
 #include "newtype_debug_print.h"
+#include "newtype_probes.h"
+#include "newtype_trace.h"
 #include "structmember.h"  // Include for PyMemberDef and related macros
 
+#if PY_VERSION_HEX < 0x030900A4
+#  define Py_SET_SIZE(o, size) (Py_SIZE(o) = (size))
+#endif
+#if PY_VERSION_HEX < 0x030A0000
+#  define PySet_CheckExact(op) (Py_TYPE(op) == &PySet_Type)
+#endif
+#if PY_VERSION_HEX < 0x03090000
+#  define PyObject_Vectorcall _PyObject_Vectorcall
+#endif
+#if PY_VERSION_HEX < 0x030B0000
+typedef PyObject* PyDictValues;
+#endif
+
+// Most positional arguments passed to an unbound function without a tuple
+#define NEWTYPE_STACK_ARGS 8
+
+#define NEWTYPE_VALIDATE_STR "_newtype_validate_"
+
+// Interned `NEWTYPE_PENDING_STR`
+static PyObject* NEWTYPE_PENDING = NULL;
+
+// Interned `NEWTYPE_INIT_ARGS_STR` and `NEWTYPE_INIT_KWARGS_STR`
+static PyObject* NEWTYPE_INIT_ARGS = NULL;
+static PyObject* NEWTYPE_INIT_KWARGS = NULL;
+// Interned "__dict__" and "__slots__", looked up on results to rewrap
+static PyObject* NEWTYPE_DUNDER_DICT = NULL;
+static PyObject* NEWTYPE_DUNDER_SLOTS = NULL;
+// Interned "_value2member_map_", the table of the members of an enum by value
+static PyObject* NEWTYPE_VALUE2MEMBER = NULL;
+// Interned `NEWTYPE_INIT_READS_VALUE_STR` and `NEWTYPE_INIT_FILLS_STR`
+static PyObject* NEWTYPE_INIT_READS_VALUE = NULL;
+static PyObject* NEWTYPE_INIT_FILLS = NULL;
+
+// `ContextVar` set to `True` inside `newtype.raw()`, and the number of such
+// scopes currently entered in any context; while that number is zero, the
+// variable need not be looked up at all
+static PyObject* NEWTYPE_RAW = NULL;
+static Py_ssize_t NEWTYPE_RAW_SCOPES = 0;
+
 static void set___isabstractmethod__(NewTypeMethodObject* self, PyObject* func)
 {
   int res = _PyObject_IsAbstract(func);
@@ -23,9 +64,20 @@ static int NewTypeMethod_init(NewTypeMethodObject* self,
                               PyObject* args,
                               PyObject* kwds)
 {
+  static char* kwlist[] = {
+      "func", "wrapped_cls", "lazy", "invariant", "rewrap", NULL};
   PyObject *func, *wrapped_cls;
   int is_callable;
-  if (!PyArg_ParseTuple(args, "OO", &func, &wrapped_cls))
+  int lazy = 0, invariant = 0, rewrap = 1;
+  if (!PyArg_ParseTupleAndKeywords(args,
+                                   kwds,
+                                   "OO|$ppp",
+                                   kwlist,
+                                   &func,
+                                   &wrapped_cls,
+                                   &lazy,
+                                   &invariant,
+                                   &rewrap))
     return -1;
 
   is_callable = PyCallable_Check(func);
@@ -33,6 +85,12 @@ static int NewTypeMethod_init(NewTypeMethodObject* self,
   if (PyObject_HasAttrString(func, "__get__") && is_callable) {
     self->func_get = PyObject_GetAttrString(func, "__get__");
     self->has_get = 1;
+    if (PyFunction_Check(func) || Py_TYPE(func) == &PyMethodDescr_Type
+        || Py_TYPE(func) == &PyWrapperDescr_Type)
+    {
+      self->func = func;
+      Py_INCREF(func);
+    }
   } else if (is_callable) {
     self->func_get = func;
     Py_INCREF(self->func_get);
@@ -46,9 +104,20 @@ static int NewTypeMethod_init(NewTypeMethodObject* self,
   }
   self->wrapped_cls = wrapped_cls;
   Py_INCREF(self->wrapped_cls);
+  self->lazy = lazy;
+  self->invariant = invariant;
+  self->rewrap = rewrap;
 
   set___isabstractmethod__(self, func);
 
+  self->name = PyObject_GetAttrString(func, "__name__");
+  if (self->name == NULL) {
+    if (!PyErr_ExceptionMatches(PyExc_AttributeError)) {
+      return -1;
+    }
+    PyErr_Clear();
+  }
+
   return 0;
 }
 
@@ -57,23 +126,368 @@ static PyObject* NewTypeMethod_get(NewTypeMethodObject* self,
                                    PyObject* inst,
                                    PyObject* owner)
 {
-  Py_XDECREF(self->obj);  // Decrease reference to old object
-  Py_XDECREF(self->cls);  // Decrease reference to old class
+  PyObject* old_obj = self->obj;
+  PyTypeObject* old_cls = self->cls;
 
   self->obj = inst;
   Py_XINCREF(self->obj);  // Increase reference to new object
   self->cls = (PyTypeObject*)owner;
   Py_XINCREF(self->cls);  // Increase reference to new class
+  // released last, as deallocating them may run code that reaches `self`
+  Py_XDECREF(old_obj);
+  Py_XDECREF(old_cls);
   Py_INCREF(self);
   return (PyObject*)self;
 }
 
+// Runs the validation deferred by a lazy NewType, if `obj` is still pending
+static int NewTypeMethod_validate(PyObject* obj)
+{
+  PyObject *raw, *res;
+  int r = _PyObject_LookupAttr(obj, NEWTYPE_PENDING, &raw);
+  if (r <= 0) {
+    return r;
+  }
+  Py_DECREF(raw);
+  DEBUG_PRINT("validating pending `obj`\n");
+  res = PyObject_CallMethod(obj, NEWTYPE_VALIDATE_STR, NULL);
+  if (res == NULL) {
+    return -1;
+  }
+  Py_DECREF(res);
+  return 0;
+}
+
+// Returns 1 if results are to be returned unwrapped in the current context
+static int NewTypeMethod_in_raw_scope(void)
+{
+  PyObject* value;
+  int r;
+
+  if (NEWTYPE_RAW_SCOPES == 0) {
+    return 0;
+  }
+  if (PyContextVar_Get(NEWTYPE_RAW, Py_False, &value) < 0) {
+    return -1;
+  }
+  r = value == Py_True;
+  Py_DECREF(value);
+  return r;
+}
+
+// Records the arguments `inst` was built with, as `NewTypeInit` would, without
+// running the user's `__init__`
+static int NewTypeMethod_record_init(PyObject* inst,
+                                     PyObject* args_combined,
+                                     PyObject* init_kwargs)
+{
+  PyObject *init_args, *kwds_record;
+  int r;
+
+  init_args =
+      PyTuple_GetSlice(args_combined, 1, PyTuple_GET_SIZE(args_combined));
+  if (init_args == NULL) {
+    return -1;
+  }
+  r = PyObject_SetAttr(inst, NEWTYPE_INIT_ARGS, init_args);
+  Py_DECREF(init_args);
+  if (r < 0) {
+    return -1;
+  }
+
+  if (init_kwargs != NULL) {
+    kwds_record = init_kwargs;
+    Py_INCREF(kwds_record);
+  } else {
+    kwds_record = PyDict_New();
+    if (kwds_record == NULL) {
+      return -1;
+    }
+  }
+  r = PyObject_SetAttr(inst, NEWTYPE_INIT_KWARGS, kwds_record);
+  Py_DECREF(kwds_record);
+  return r;
+}
+
+// Returns 1 if results of invariant-preserving methods can skip the user's
+// `__init__`; a lazy receiver accessed through the class may never have been
+// validated
+static int NewTypeMethod_skips_init(NewTypeMethodObject* self)
+{
+  return self->invariant && !(self->lazy && self->obj == NULL);
+}
+
+// Fills `new_inst`, an instance of a subtype that was just built around the
+// exact container `result`, with the contents of `result` if it is still
+// empty, as `BaseNewType.__new__` leaves it. If `steal` is set, a container
+// that only the arguments of that construction refer to hands its storage
+// over in constant time, and is left empty; otherwise `result` is left as it
+// is, for `__init__` to receive. Copied dicts and sets go through the
+// table-cloning fast path taken when merging into an empty container.
+static int NewTypeMethod_move_contents(PyObject* new_inst,
+                                       PyObject* result,
+                                       int steal)
+{
+  steal = steal && Py_REFCNT(result) == 1;
+
+  if (PyList_CheckExact(result) && PyList_Check(new_inst)
+      && PyList_GET_SIZE(new_inst) == 0)
+  {
+    PyListObject* src = (PyListObject*)result;
+    PyListObject* dst = (PyListObject*)new_inst;
+    PyObject** items = dst->ob_item;
+    Py_ssize_t allocated = dst->allocated;
+
+    if (!steal) {
+      return PyList_SetSlice(new_inst, 0, 0, result);
+    }
+    DEBUG_PRINT("moving %zd items into `new_inst`\n", Py_SIZE(src));
+    dst->ob_item = src->ob_item;
+    dst->allocated = src->allocated;
+    Py_SET_SIZE(dst, Py_SIZE(src));
+    src->ob_item = items;
+    src->allocated = allocated;
+    Py_SET_SIZE(src, 0);
+    return 0;
+  }
+
+  if (PyDict_CheckExact(result) && PyDict_Check(new_inst)
+      && PyDict_GET_SIZE(new_inst) == 0)
+  {
+    PyDictObject* src = (PyDictObject*)result;
+    PyDictObject* dst = (PyDictObject*)new_inst;
+    PyDictKeysObject* keys = dst->ma_keys;
+    PyDictValues* values = dst->ma_values;
+
+    // a split table shares its keys with the instances of a class, so only
+    // combined tables change hands; `result` takes whatever empty table
+    // `new_inst` had (before 3.11 that has values too). Neither dict can be
+    // known yet to a cache that checks its version, and `new_inst`, an
+    // instance of a heap type, is tracked by the GC already.
+    if (!steal || src->ma_values != NULL) {
+      return PyDict_Update(new_inst, result);
+    }
+    DEBUG_PRINT("moving %zd items into `new_inst`\n", src->ma_used);
+    dst->ma_keys = src->ma_keys;
+    dst->ma_values = NULL;
+    dst->ma_used = src->ma_used;
+    src->ma_keys = keys;
+    src->ma_values = values;
+    src->ma_used = 0;
+    return 0;
+  }
+
+  if (PySet_CheckExact(result) && PySet_Check(new_inst)
+      && PySet_GET_SIZE(new_inst) == 0)
+  {
+    PySetObject* src = (PySetObject*)result;
+    PySetObject* dst = (PySetObject*)new_inst;
+    PyObject* res;
+
+    if (steal && src->table != src->smalltable
+        && dst->table == dst->smalltable)
+    {
+      // only a table of its own can change hands, and `result` takes over
+      // the small table of `new_inst` in exchange
+      DEBUG_PRINT("moving %zd items into `new_inst`\n", src->used);
+      dst->table = src->table;
+      dst->fill = src->fill;
+      dst->used = src->used;
+      dst->mask = src->mask;
+      dst->finger = src->finger;
+      src->table = src->smalltable;
+      memset(src->smalltable, 0, sizeof(src->smalltable));
+      src->fill = 0;
+      src->used = 0;
+      src->mask = PySet_MINSIZE - 1;
+      src->finger = 0;
+      return 0;
+    }
+    // `set.__ior__` itself, not the wrapped method of the subtype
+    res = PySet_Type.tp_as_number->nb_inplace_or(new_inst, result);
+    if (res == NULL) {
+      return -1;
+    }
+    Py_DECREF(res);
+  }
+  return 0;
+}
+
+// Returns 1 if constructing `cls` may look at the value given to `__init__`,
+// which then has to keep its contents until `__init__` returns
+static int NewTypeMethod_init_reads_value(PyTypeObject* cls)
+{
+  return _PyType_Lookup(cls, NEWTYPE_INIT_READS_VALUE) != Py_False;
+}
+
+// Returns 1 if the `__init__` of `cls` has been seen to fill the instance
+// itself, as `NewTypeInit` notes in the dict of `cls`; subclasses with an
+// `__init__` of their own may not
+static int NewTypeMethod_init_fills(PyTypeObject* cls)
+{
+  PyObject* fills = PyDict_GetItemWithError(cls->tp_dict, NEWTYPE_INIT_FILLS);
+  if (fills == NULL) {
+    return PyErr_Occurred() ? -1 : 0;
+  }
+  return fills == Py_True;
+}
+
+// Builds the `self->cls` instance wrapping `args_combined[0]`. The contents of
+// a container result are put in before the user's `__init__` runs, so that it
+// validates them. The results of invariant-preserving methods need no
+// re-validation, so they skip `__init__`, and only get the init arguments
+// recorded, as `NewTypeInit` would.
+static PyObject* NewTypeMethod_rewrap(NewTypeMethodObject* self,
+                                      PyObject* args_combined,
+                                      PyObject* init_kwargs)
+{
+  PyTypeObject* cls = self->cls;
+  PyObject* result = PyTuple_GET_ITEM(args_combined, 0);
+  PyObject* new_inst;
+  initproc init;
+  unsigned long long start;
+  int r, fills = 0;
+
+  if (!NewTypeMethod_skips_init(self)) {
+    fills = NewTypeMethod_init_fills(cls);
+    if (fills < 0) {
+      return NULL;
+    }
+  }
+  if (cls->tp_new == NULL
+      || (!NewTypeMethod_skips_init(self)
+          && (fills || Py_TYPE(cls)->tp_call != PyType_Type.tp_call)))
+  {
+    // a metaclass may build instances its own way, and an `__init__` that
+    // fills the instance would replace contents put in before it runs, so
+    // they are only put in once it is done, if it left the instance empty
+    start = NEWTYPE_STATS_START();
+    NEWTYPE_STATS_ADD(self->stats, validations, 1);
+    new_inst = PyObject_Call((PyObject*)cls, args_combined, init_kwargs);
+    NEWTYPE_STATS_LATENCY(self->stats, start);
+    if (new_inst == NULL) {
+      NEWTYPE_STATS_ADD(self->stats, validation_failures, 1);
+    } else if (NewTypeMethod_move_contents(new_inst, result, 1) < 0) {
+      Py_CLEAR(new_inst);
+    }
+    return new_inst;
+  }
+
+  // what `type.__call__` does, with the contents put in between
+  new_inst = cls->tp_new(cls, args_combined, init_kwargs);
+  if (new_inst == NULL || !PyObject_TypeCheck(new_inst, cls)) {
+    return new_inst;
+  }
+  if (NewTypeMethod_skips_init(self)) {
+    DEBUG_PRINT("rewrapping without `__init__`\n");
+    if (NewTypeMethod_move_contents(new_inst, result, 1) < 0
+        || NewTypeMethod_record_init(new_inst, args_combined, init_kwargs) < 0)
+    {
+      Py_DECREF(new_inst);
+      return NULL;
+    }
+    return new_inst;
+  }
+  if (NewTypeMethod_move_contents(
+          new_inst, result, !NewTypeMethod_init_reads_value(cls))
+      < 0)
+  {
+    Py_DECREF(new_inst);
+    return NULL;
+  }
+  init = Py_TYPE(new_inst)->tp_init;
+  if (init != NULL) {
+    start = NEWTYPE_STATS_START();
+    NEWTYPE_STATS_ADD(self->stats, validations, 1);
+    r = init(new_inst, args_combined, init_kwargs);
+    NEWTYPE_STATS_LATENCY(self->stats, start);
+    if (r < 0) {
+      NEWTYPE_STATS_ADD(self->stats, validation_failures, 1);
+      Py_DECREF(new_inst);
+      return NULL;
+    }
+  }
+  return new_inst;
+}
+
+// The member of `cls` whose value is `value`, if `cls` is an `Enum` mixing in
+// a NewType. Its members were built and validated once, when `cls` was
+// created, so `cls(value)` would return that same member; looking it up in
+// the table `EnumMeta` keeps skips the call into the enum machinery. Returns
+// a new reference, or NULL without an exception set if there is no such
+// member, including when `value` is unhashable or matches through
+// `_missing_`, which the call still handles.
+static PyObject* NewTypeMethod_enum_member(PyTypeObject* cls, PyObject* value)
+{
+  PyObject *members, *member;
+
+  members = PyDict_GetItemWithError(cls->tp_dict, NEWTYPE_VALUE2MEMBER);
+  if (members == NULL || !PyDict_CheckExact(members)) {
+    PyErr_Clear();
+    return NULL;
+  }
+  member = PyDict_GetItemWithError(members, value);
+  if (member == NULL || !PyObject_TypeCheck(member, cls)) {
+    PyErr_Clear();
+    return NULL;
+  }
+  Py_INCREF(member);
+  return member;
+}
+
+// Calls `self->func` as bound to `self->obj`, if any, with the positional
+// `args`, fewer than `NEWTYPE_STACK_ARGS` of them
+static PyObject* NewTypeMethod_call_unbound(NewTypeMethodObject* self,
+                                            PyObject* args)
+{
+  PyObject* stack[NEWTYPE_STACK_ARGS];
+  Py_ssize_t i, nargs = PyTuple_GET_SIZE(args);
+
+  if (self->obj == NULL) {
+    return PyObject_Call(self->func, args, NULL);
+  }
+  stack[0] = self->obj;
+  for (i = 0; i < nargs; i++) {
+    stack[i + 1] = PyTuple_GET_ITEM(args, i);
+  }
+  return PyObject_Vectorcall(self->func, stack, nargs + 1, NULL);
+}
+
+// The name of the method for the probes
+static inline const char* NewTypeMethod_probe_name(NewTypeMethodObject* self)
+{
+  const char* name;
+  if (self->name == NULL || !PyUnicode_Check(self->name)) {
+    return "?";
+  }
+  name = PyUnicode_AsUTF8(self->name);
+  if (name == NULL) {
+    PyErr_Clear();
+    return "?";
+  }
+  return name;
+}
+
+// Fires `newtype:rewrap` for a result rewrapped into `self->cls`, `start`
+// being when the method was entered
+static inline void NewTypeMethod_probe_rewrap(NewTypeMethodObject* self,
+                                              unsigned long long start)
+{
+  if (NEWTYPE_PROBE_ENABLED(rewrap)) {
+    NEWTYPE_PROBE3(rewrap,
+                   NewTypeProbe_type_name(self->cls),
+                   NewTypeMethod_probe_name(self),
+                   start != 0 ? NewTypeStats_now() - start : 0);
+  }
+}
+
 // Call method to wrap the function call
 static PyObject* NewTypeMethod_call(NewTypeMethodObject* self,
                                     PyObject* args,
                                     PyObject* kwargs)
 {
   PyObject *func, *result;
+  unsigned long long probe_start = 0;
 
   // This causes recursion for pandas DataFrame
   // if (self->obj != NULL) {
@@ -86,6 +500,39 @@ static PyObject* NewTypeMethod_call(NewTypeMethodObject* self,
                 PyUnicode_AsUTF8(PyObject_Repr((PyObject*)self->cls)));
   }
 
+  NEWTYPE_STATS_ADD(self->stats, calls, 1);
+  NEWTYPE_TRACE(NEWTYPE_TRACE_METHOD_CALL, self->cls);
+  if (NEWTYPE_PROBE_ENABLED(method_entry)) {
+    NEWTYPE_PROBE2(method_entry,
+                   NewTypeProbe_type_name(self->cls),
+                   NewTypeMethod_probe_name(self));
+  }
+  if (NEWTYPE_PROBE_ENABLED(rewrap)) {
+    probe_start = NewTypeStats_now();
+  }
+
+  if (self->lazy) {
+    // accessed through the class, the receiver is the first argument
+    PyObject* receiver = self->obj;
+    if (receiver == NULL && self->cls != NULL && PyTuple_GET_SIZE(args) > 0
+        && PyObject_TypeCheck(PyTuple_GET_ITEM(args, 0), self->cls))
+    {
+      receiver = PyTuple_GET_ITEM(args, 0);
+    }
+    if (receiver != NULL && NewTypeMethod_validate(receiver) < 0) {
+      return NULL;
+    }
+  }
+
+  if (self->func != NULL && (kwargs == NULL || PyDict_GET_SIZE(kwargs) == 0)
+      && PyTuple_GET_SIZE(args) < NEWTYPE_STACK_ARGS)
+  {
+    // binding `func` would only create a bound method to prepend `obj` to the
+    // arguments, so prepend it here instead
+    result = NewTypeMethod_call_unbound(self, args);
+    goto called;
+  }
+
   if (self->has_get) {
     DEBUG_PRINT("`self->has_get` = %d\n", self->has_get);
     if (self->obj == NULL) {
@@ -115,30 +562,39 @@ static PyObject* NewTypeMethod_call(NewTypeMethodObject* self,
   result = PyObject_Call(func, args, kwargs);
   Py_DECREF(func);
 
-  if (result == NULL)
-    return NULL;
-  DEBUG_PRINT("`result` = %s\n", PyUnicode_AsUTF8(PyObject_Repr(result)));
-
-  // Need to save `result.__dict__` so that we can copy over the attributes
-  // from `self->obj` to `new_inst`, if `self->obj` is not NULL because
-  // constructor will remove the `__dict__` attribute from `result`
-  PyObject* result_dict = NULL;
-  if (PyObject_HasAttrString(result, "__dict__")) {
-    result_dict = PyObject_GetAttrString(result, "__dict__");
+called:
+  if (result == NULL || !self->rewrap)
+    return result;
+
+  switch (NewTypeMethod_in_raw_scope()) {
+    case 0:
+      break;
+    case 1:
+      DEBUG_PRINT("inside `raw()`, returning `result` as is\n");
+      return result;
+    default:
+      Py_DECREF(result);
+      return NULL;
   }
+  DEBUG_PRINT("`result` = %s\n", PyUnicode_AsUTF8(PyObject_Repr(result)));
 
-  PyObject* result_slots = NULL;
-  if (PyObject_HasAttrString(result, "__slots__")) {
-    result_slots = PyObject_GetAttrString(result, "__slots__");
+  if (self->obj != NULL && self->cls != NULL
+      && !PyObject_TypeCheck(result, self->cls))
+  {
+    PyObject* member = NewTypeMethod_enum_member(self->cls, result);
+    if (member != NULL) {
+      DEBUG_PRINT("`result` is the value of an enum member\n");
+      NEWTYPE_STATS_ADD(self->stats, fast_path, 1);
+      Py_DECREF(result);
+      return member;
+    }
   }
 
   if (self->obj == NULL && self->cls == NULL) {
-    Py_XDECREF(result_dict);  // Clean up before goto
     goto done;
   }
 
   if (self->cls && PyObject_TypeCheck(result, self->cls)) {
-    Py_XDECREF(result_dict);  // Clean up before goto
     goto done;
   }
 
@@ -169,23 +625,23 @@ static PyObject* NewTypeMethod_call(NewTypeMethodObject* self,
         goto done;
       };
       if (PyObject_IsInstance(first_elem, (PyObject*)self->cls)) {
-        init_args = PyObject_GetAttrString(first_elem, NEWTYPE_INIT_ARGS_STR);
-        init_kwargs =
-            PyObject_GetAttrString(first_elem, NEWTYPE_INIT_KWARGS_STR);
+        init_args = PyObject_GetAttr(first_elem, NEWTYPE_INIT_ARGS);
+        init_kwargs = PyObject_GetAttr(first_elem, NEWTYPE_INIT_KWARGS);
         DEBUG_PRINT("`init_args`: %s\n",
                     PyUnicode_AsUTF8(PyObject_Repr(init_args)));
         DEBUG_PRINT("`init_kwargs`: %s\n",
                     PyUnicode_AsUTF8(PyObject_Repr(init_kwargs)));
       } else {  // first element is not the subtype, so we are done also
         DEBUG_PRINT("`first_elem` is not the subtype\n");
+        Py_DECREF(first_elem);
         goto done;
       }
       Py_XDECREF(first_elem);
     } else {  // `self->obj` is not NULL
 
       DEBUG_PRINT("`self->obj` is not NULL\n");
-      init_args = PyObject_GetAttrString(self->obj, NEWTYPE_INIT_ARGS_STR);
-      init_kwargs = PyObject_GetAttrString(self->obj, NEWTYPE_INIT_KWARGS_STR);
+      init_args = PyObject_GetAttr(self->obj, NEWTYPE_INIT_ARGS);
+      init_kwargs = PyObject_GetAttr(self->obj, NEWTYPE_INIT_KWARGS);
       DEBUG_PRINT("`init_args`: %s\n",
                   PyUnicode_AsUTF8(PyObject_Repr(init_args)));
       DEBUG_PRINT("`init_kwargs`: %s\n",
@@ -267,10 +723,10 @@ static PyObject* NewTypeMethod_call(NewTypeMethodObject* self,
       PyTuple_SET_ITEM(args_combined, 0, result);
       DEBUG_PRINT("`args_combined`: %s\n",
                   PyUnicode_AsUTF8(PyObject_Repr(args_combined)));
-      new_inst =
-          PyObject_Call((PyObject*)self->cls, args_combined, init_kwargs);
+      new_inst = NewTypeMethod_rewrap(self, args_combined, init_kwargs);
       if (new_inst == NULL) {
         DEBUG_PRINT("`new_inst` is NULL\n");
+        NEWTYPE_TRACE(NEWTYPE_TRACE_REWRAP_FAIL, self->cls);
         Py_DECREF(result);
         Py_DECREF(self->obj);
         Py_DECREF(args_combined);
@@ -281,10 +737,32 @@ static PyObject* NewTypeMethod_call(NewTypeMethodObject* self,
       Py_DECREF(args_combined);
       DEBUG_PRINT("`new_inst`: %s\n",
                   PyUnicode_AsUTF8(PyObject_Repr(new_inst)));
+      NEWTYPE_STATS_ADD(self->stats, rewraps, 1);
+      NEWTYPE_TRACE(NEWTYPE_TRACE_REWRAP, self->cls);
+      NewTypeMethod_probe_rewrap(self, probe_start);
       return new_inst;
     }
 
-    new_inst = PyObject_Call((PyObject*)self->cls, args_combined, init_kwargs);
+    // Need to save `result.__dict__` so that we can copy over the attributes
+    // from `self->obj` to `new_inst`, if `self->obj` is not NULL because
+    // constructor will remove the `__dict__` attribute from `result`; they are
+    // only looked up here, so that results returned as they are cost nothing
+    PyObject *result_dict = NULL, *result_slots = NULL;
+    if (_PyObject_LookupAttr(result, NEWTYPE_DUNDER_DICT, &result_dict) < 0
+        || _PyObject_LookupAttr(result, NEWTYPE_DUNDER_SLOTS, &result_slots)
+               < 0)
+    {
+      Py_XDECREF(result_dict);
+      Py_DECREF(args_combined);
+      Py_XDECREF(init_args);
+      Py_XDECREF(init_kwargs);
+      return NULL;
+    }
+
+    new_inst = NewTypeMethod_rewrap(self, args_combined, init_kwargs);
+    if (new_inst != NULL) {
+      NEWTYPE_TRACE(NEWTYPE_TRACE_REWRAP, self->cls);
+    }
 
     // Clean up
     Py_XDECREF(args_combined);  // Decrement reference count of `args_combined`
@@ -346,6 +824,7 @@ static PyObject* NewTypeMethod_call(NewTypeMethodObject* self,
             value = PyObject_GetAttr(self->obj, key);
             if (value != NULL) {
               if (PyObject_SetAttr(new_inst, key, value) >= 0) {
+                NEWTYPE_STATS_ADD(self->stats, attributes_copied, 1);
                 DEBUG_PRINT("`key` = `%s`, `value` = `%s` has been set\n",
                             PyUnicode_AsUTF8(PyObject_Repr(key)),
                             PyUnicode_AsUTF8(PyObject_Repr(value)));
@@ -412,6 +891,7 @@ static PyObject* NewTypeMethod_call(NewTypeMethodObject* self,
             value = PyObject_GetAttr(self->obj, key);
             if (value != NULL) {
               if (PyObject_SetAttr(new_inst, key, value) >= 0) {
+                NEWTYPE_STATS_ADD(self->stats, attributes_copied, 1);
                 DEBUG_PRINT("`key` = `%s`, `value` = `%s` has been set\n",
                             PyUnicode_AsUTF8(PyObject_Repr(key)),
                             PyUnicode_AsUTF8(PyObject_Repr(value)));
@@ -463,6 +943,7 @@ static PyObject* NewTypeMethod_call(NewTypeMethodObject* self,
             value = PyObject_GetAttr(self->obj, key);
             if (value != NULL) {
               if (PyObject_SetAttr(new_inst, key, value) >= 0) {
+                NEWTYPE_STATS_ADD(self->stats, attributes_copied, 1);
                 DEBUG_PRINT("`key` = `%s`, `value` = `%s` has been set\n",
                             PyUnicode_AsUTF8(PyObject_Repr(key)),
                             PyUnicode_AsUTF8(PyObject_Repr(value)));
@@ -488,12 +969,18 @@ static PyObject* NewTypeMethod_call(NewTypeMethodObject* self,
     // && result_slots != NULL)
 
     Py_XDECREF(result_dict);
+    Py_XDECREF(result_slots);
     DEBUG_PRINT("`new_inst`: %s\n", PyUnicode_AsUTF8(PyObject_Repr(new_inst)));
+    if (new_inst != NULL) {
+      NEWTYPE_STATS_ADD(self->stats, rewraps, 1);
+      NewTypeMethod_probe_rewrap(self, probe_start);
+    } else {
+      NEWTYPE_TRACE(NEWTYPE_TRACE_REWRAP_FAIL, self->cls);
+    }
     return new_inst;
   }
 
 done:
-  Py_XINCREF(result);
   DEBUG_PRINT("DONE! `result`: %s\n", PyUnicode_AsUTF8(PyObject_Repr(result)));
   return result;
 }
@@ -501,21 +988,61 @@ done:
 // Deallocation method
 static void NewTypeMethod_dealloc(NewTypeMethodObject* self)
 {
+  PyObject_GC_UnTrack(self);
   Py_XDECREF(self->func_get);
+  Py_XDECREF(self->func);
+  Py_XDECREF(self->name);
   Py_XDECREF(self->wrapped_cls);
   Py_XDECREF(self->obj);
   Py_XDECREF(self->cls);
+  NewTypeStats_clear(&self->stats);
   Py_TYPE(self)->tp_free((PyObject*)self);
 }
 
+static PyObject* NewTypeMethod_stats(NewTypeMethodObject* self,
+                                     PyObject* Py_UNUSED(ignored))
+{
+  return NewTypeStats_as_dict(&self->stats);
+}
+
+static PyObject* NewTypeMethod_latency(NewTypeMethodObject* self,
+                                       PyObject* Py_UNUSED(ignored))
+{
+  return NewTypeStats_latency(&self->stats);
+}
+
+static PyObject* NewTypeMethod_reset_stats(NewTypeMethodObject* self,
+                                           PyObject* Py_UNUSED(ignored))
+{
+  NewTypeStats_reset(&self->stats);
+  Py_RETURN_NONE;
+}
+
 // Method definitions
-static PyMethodDef NewTypeMethod_methods[] = {{NULL, NULL, 0, NULL}};
+static PyMethodDef NewTypeMethod_methods[] = {
+    {"stats",
+     (PyCFunction)NewTypeMethod_stats,
+     METH_NOARGS,
+     "Return the counters of the method, kept while statistics are enabled."},
+    {"latency",
+     (PyCFunction)NewTypeMethod_latency,
+     METH_NOARGS,
+     "Return the histogram of the latencies of the rewraps of the method, as "
+     "`(lower ns, upper ns, count)` tuples."},
+    {"reset_stats",
+     (PyCFunction)NewTypeMethod_reset_stats,
+     METH_NOARGS,
+     "Set the counters of the method back to zero."},
+    {NULL, NULL, 0, NULL}};
 
 static int NewTypeMethodObject_traverse(PyObject* self,
                                         visitproc visit,
                                         void* arg)
 {
   NewTypeMethodObject* pp = (NewTypeMethodObject*)self;
+  Py_VISIT(pp->func_get);
+  Py_VISIT(pp->func);
+  Py_VISIT(pp->name);
   Py_VISIT(pp->cls);
   Py_VISIT(pp->obj);
   Py_VISIT(pp->wrapped_cls);
@@ -525,6 +1052,9 @@ static int NewTypeMethodObject_traverse(PyObject* self,
 static int NewTypeMethodObject_clear(PyObject* self)
 {
   NewTypeMethodObject* pp = (NewTypeMethodObject*)self;
+  Py_CLEAR(pp->func_get);
+  Py_CLEAR(pp->func);
+  Py_CLEAR(pp->name);
   Py_CLEAR(pp->cls);
   Py_CLEAR(pp->obj);
   Py_CLEAR(pp->wrapped_cls);
@@ -536,6 +1066,13 @@ static PyMemberDef newtypemethodobject_members[] = {
      T_OBJECT,
      offsetof(NewTypeMethodObject, __isabstractmethod__),
      READONLY},
+    // read by `newtype.monitoring` around each call, without building the
+    // dict of `stats()`
+    {"cls", T_OBJECT, offsetof(NewTypeMethodObject, cls), READONLY},
+    {"rewraps",
+     T_ULONGLONG,
+     offsetof(NewTypeMethodObject, stats.rewraps),
+     READONLY},
     {0}};
 
 // Type definition
@@ -560,6 +1097,61 @@ PyTypeObject NewTypeMethodType = {
     .tp_clear = NewTypeMethodObject_clear,
 };
 
+static PyObject* newtypemethod_raw_enter(PyObject* module,
+                                         PyObject* Py_UNUSED(ignored))
+{
+  PyObject* token = PyContextVar_Set(NEWTYPE_RAW, Py_True);
+  if (token != NULL) {
+    NEWTYPE_RAW_SCOPES++;
+  }
+  return token;
+}
+
+static PyObject* newtypemethod_raw_exit(PyObject* module, PyObject* token)
+{
+  if (PyContextVar_Reset(NEWTYPE_RAW, token) < 0) {
+    return NULL;
+  }
+  NEWTYPE_RAW_SCOPES--;
+  Py_RETURN_NONE;
+}
+
+static PyMethodDef newtypemethod_module_methods[] = {
+    {"raw_enter",
+     (PyCFunction)newtypemethod_raw_enter,
+     METH_NOARGS,
+     "Make `NewTypeMethod`s return unwrapped results in the current context; "
+     "returns the token to pass to `raw_exit`."},
+    {"raw_exit",
+     (PyCFunction)newtypemethod_raw_exit,
+     METH_O,
+     "Undo the matching `raw_enter`."},
+    {"set_stats_enabled",
+     (PyCFunction)NewTypeStats_set_enabled,
+     METH_O,
+     "Make the `NewTypeMethod`s keep counters or not; returns whether they "
+     "did."},
+    {"set_latency_enabled",
+     (PyCFunction)NewTypeStats_set_latency_enabled,
+     METH_O,
+     "Make the `NewTypeMethod`s record the latencies of rewraps or not; "
+     "returns whether they did."},
+    {"set_trace_enabled",
+     (PyCFunction)NewTypeTrace_set_enabled,
+     METH_O,
+     "Make the `NewTypeMethod`s record trace events or not; returns whether "
+     "they did."},
+    {"trace_records",
+     (PyCFunction)NewTypeTrace_records,
+     METH_NOARGS,
+     "Return the trace records of the `NewTypeMethod`s, as `(thread id, ns, "
+     "event, type address)` tuples."},
+    {"trace_clear",
+     (PyCFunction)NewTypeTrace_clear,
+     METH_NOARGS,
+     "Drop the trace records of the `NewTypeMethod`s."},
+    {NULL, NULL, 0, NULL}};
+
 // Module definition
 static struct PyModuleDef newtypemethodmodule = {
     PyModuleDef_HEAD_INIT,
@@ -569,7 +1161,7 @@ static struct PyModuleDef newtypemethodmodule = {
         "that wraps around regular methods of a class to allow instantiation "
         "of the subtype if the method returns an instance of the supertype.",
     .m_size = -1,
-    .m_methods = NewTypeMethod_methods,
+    .m_methods = newtypemethod_module_methods,
 };
 
 // Module initialization function
@@ -578,6 +1170,40 @@ PyMODINIT_FUNC PyInit_newtypemethod(void)
   if (PyType_Ready(&NewTypeMethodType) < 0)
     return NULL;
 
+  if (NEWTYPE_PENDING == NULL) {
+    NEWTYPE_PENDING = PyUnicode_InternFromString(NEWTYPE_PENDING_STR);
+    if (NEWTYPE_PENDING == NULL)
+      return NULL;
+    NEWTYPE_VALUE2MEMBER = PyUnicode_InternFromString("_value2member_map_");
+    if (NEWTYPE_VALUE2MEMBER == NULL)
+      return NULL;
+    NEWTYPE_INIT_ARGS = PyUnicode_InternFromString(NEWTYPE_INIT_ARGS_STR);
+    if (NEWTYPE_INIT_ARGS == NULL)
+      return NULL;
+    NEWTYPE_INIT_KWARGS = PyUnicode_InternFromString(NEWTYPE_INIT_KWARGS_STR);
+    if (NEWTYPE_INIT_KWARGS == NULL)
+      return NULL;
+    NEWTYPE_DUNDER_DICT = PyUnicode_InternFromString("__dict__");
+    if (NEWTYPE_DUNDER_DICT == NULL)
+      return NULL;
+    NEWTYPE_DUNDER_SLOTS = PyUnicode_InternFromString("__slots__");
+    if (NEWTYPE_DUNDER_SLOTS == NULL)
+      return NULL;
+    NEWTYPE_INIT_READS_VALUE =
+        PyUnicode_InternFromString(NEWTYPE_INIT_READS_VALUE_STR);
+    if (NEWTYPE_INIT_READS_VALUE == NULL)
+      return NULL;
+    NEWTYPE_INIT_FILLS = PyUnicode_InternFromString(NEWTYPE_INIT_FILLS_STR);
+    if (NEWTYPE_INIT_FILLS == NULL)
+      return NULL;
+  }
+
+  if (NEWTYPE_RAW == NULL) {
+    NEWTYPE_RAW = PyContextVar_New("newtype_raw", Py_False);
+    if (NEWTYPE_RAW == NULL)
+      return NULL;
+  }
+
   PyObject* m = PyModule_Create(&newtypemethodmodule);
   if (m == NULL)
     return NULL;
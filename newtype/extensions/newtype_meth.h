@@ -3,15 +3,22 @@
 
 #include <Python.h>
 #include "newtype_init.h"
+#include "newtype_stats.h"
 
 // Struct for the NewTypeMethod object
 typedef struct NewTypeMethodObject {
   PyObject_HEAD PyObject *func_get;
   int has_get;
+  PyObject *func;  // the function, if binding it just passes `obj` first
+  PyObject *name;  // `__name__` of the function, if any, for the probes
   PyObject *__isabstractmethod__;
   PyObject *wrapped_cls;
   PyObject *obj;
   PyTypeObject *cls;
+  int lazy;  // validate a pending `obj` before calling through
+  int invariant;  // results keep the invariant, so rewrap without `__init__`
+  int rewrap;  // build instances of `cls` from `wrapped_cls` results
+  NewTypeStats stats;
 } NewTypeMethodObject;
 
 // Method declarations
@@ -0,0 +1,62 @@
+#ifndef NEWTYPE_PROBES_H
+#define NEWTYPE_PROBES_H
+
+#include <Python.h>
+
+#include "newtype_stats.h"
+
+// USDT (SystemTap SDT) probes of the `newtype` provider:
+//   method_entry(type name, method name)
+//   rewrap(type name, method name, ns since the method was entered)
+//   init_validate(type name, ns spent validating)
+//   init_fail(type name, ns spent validating, exception type name)
+//
+// They are compiled in when building with `__PYNT_USDT__=true` on a system
+// with <sys/sdt.h>, and are otherwise no-ops. A compiled-in probe is a `nop`
+// until a tracer attaches to it; its arguments, and the clock reads for the
+// latencies, are behind a test of the probe's semaphore, which the tracer
+// increments while attached.
+
+#if defined(__PYNT_USDT__) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#define NEWTYPE_USDT 1
+#endif
+#endif
+
+#ifdef NEWTYPE_USDT
+
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+
+// The semaphores, one per probe in each module, named as `dtrace -G` would
+#define NEWTYPE_PROBE_SEMAPHORE(name)              \
+  static unsigned short newtype_##name##_semaphore \
+      __attribute__((used, section(".probes")))
+
+NEWTYPE_PROBE_SEMAPHORE(method_entry);
+NEWTYPE_PROBE_SEMAPHORE(rewrap);
+NEWTYPE_PROBE_SEMAPHORE(init_validate);
+NEWTYPE_PROBE_SEMAPHORE(init_fail);
+
+#define NEWTYPE_PROBE_ENABLED(name) \
+  __builtin_expect(newtype_##name##_semaphore, 0)
+#define NEWTYPE_PROBE2(name, a, b) STAP_PROBE2(newtype, name, a, b)
+#define NEWTYPE_PROBE3(name, a, b, c) STAP_PROBE3(newtype, name, a, b, c)
+
+#else
+
+// the arguments are only used in code behind `NEWTYPE_PROBE_ENABLED`, which
+// the compiler drops
+#define NEWTYPE_PROBE_ENABLED(name) 0
+#define NEWTYPE_PROBE2(name, a, b) ((void)(a), (void)(b))
+#define NEWTYPE_PROBE3(name, a, b, c) ((void)(a), (void)(b), (void)(c))
+
+#endif  // NEWTYPE_USDT
+
+// The name of a type for the probes, which take C strings
+static inline const char* NewTypeProbe_type_name(PyTypeObject* type)
+{
+  return type != NULL ? type->tp_name : "?";
+}
+
+#endif  // NEWTYPE_PROBES_H
@@ -0,0 +1,168 @@
+#define PY_SSIZE_T_CLEAN
+#include "newtype_stats.h"
+
+#include <Python.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+NewTypeFlag NewTypeStats_enabled = 0;
+NewTypeFlag NewTypeStats_latency_enabled = 0;
+
+unsigned long long NewTypeStats_now(void)
+{
+#ifdef _WIN32
+  static LARGE_INTEGER frequency;
+  LARGE_INTEGER counter;
+  if (frequency.QuadPart == 0) {
+    QueryPerformanceFrequency(&frequency);
+  }
+  QueryPerformanceCounter(&counter);
+  return (unsigned long long)(counter.QuadPart / frequency.QuadPart)
+      * 1000000000ULL
+      + (unsigned long long)(counter.QuadPart % frequency.QuadPart)
+      * 1000000000ULL / (unsigned long long)frequency.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long long)ts.tv_sec * 1000000000ULL
+      + (unsigned long long)ts.tv_nsec;
+#endif
+}
+
+// The bucket of `ns`: below 4, `ns` itself; otherwise, with `p` the position
+// of its highest bit, the two bits after it pick one of 4 buckets for `p`
+static int NewTypeHistogram_bucket(unsigned long long ns)
+{
+  int p = 0, bucket;
+  if (ns < 4) {
+    return (int)ns;
+  }
+  while ((ns >> p) > 1) {
+    p++;
+  }
+  bucket = 4 * (p - 1) + (int)((ns >> (p - 2)) & 3);
+  return bucket < NEWTYPE_HISTOGRAM_BUCKETS ? bucket
+                                            : NEWTYPE_HISTOGRAM_BUCKETS - 1;
+}
+
+// The lowest latency in `bucket`, the inverse of `NewTypeHistogram_bucket`
+static unsigned long long NewTypeHistogram_lower(int bucket)
+{
+  if (bucket < 4) {
+    return (unsigned long long)bucket;
+  }
+  return (unsigned long long)(4 + bucket % 4) << (bucket / 4 - 1);
+}
+
+void NewTypeStats_record_latency(NewTypeStats* stats, unsigned long long start)
+{
+  unsigned long long ns;
+
+  if (start == 0) {
+    return;
+  }
+  if (stats->latency == NULL) {
+    // no exception can be raised from where latencies are recorded
+    stats->latency = PyMem_RawCalloc(1, sizeof(NewTypeHistogram));
+    if (stats->latency == NULL) {
+      return;
+    }
+  }
+  ns = NewTypeStats_now() - start;
+  stats->latency->counts[NewTypeHistogram_bucket(ns)]++;
+  if (ns > stats->latency->max) {
+    stats->latency->max = ns;
+  }
+}
+
+PyObject* NewTypeStats_as_dict(const NewTypeStats* stats)
+{
+  return Py_BuildValue("{s:K,s:K,s:K,s:K,s:K,s:K}",
+                       "calls",
+                       stats->calls,
+                       "fast_path",
+                       stats->fast_path,
+                       "rewraps",
+                       stats->rewraps,
+                       "validations",
+                       stats->validations,
+                       "validation_failures",
+                       stats->validation_failures,
+                       "attributes_copied",
+                       stats->attributes_copied);
+}
+
+PyObject* NewTypeStats_latency(const NewTypeStats* stats)
+{
+  PyObject *buckets = PyList_New(0), *item;
+  unsigned long long upper;
+  int i;
+
+  if (buckets == NULL || stats->latency == NULL) {
+    return buckets;
+  }
+  for (i = 0; i < NEWTYPE_HISTOGRAM_BUCKETS; i++) {
+    if (stats->latency->counts[i] == 0) {
+      continue;
+    }
+    // only the highest bucket can hold the longest latency, and the last
+    // bucket also holds all the latencies over its range
+    upper = NewTypeHistogram_lower(i + 1) - 1;
+    if (i == NEWTYPE_HISTOGRAM_BUCKETS - 1 || upper > stats->latency->max) {
+      upper = stats->latency->max;
+    }
+    item = Py_BuildValue("(KKK)",
+                         NewTypeHistogram_lower(i),
+                         upper,
+                         stats->latency->counts[i]);
+    if (item == NULL || PyList_Append(buckets, item) < 0) {
+      Py_XDECREF(item);
+      Py_DECREF(buckets);
+      return NULL;
+    }
+    Py_DECREF(item);
+  }
+  return buckets;
+}
+
+void NewTypeStats_reset(NewTypeStats* stats)
+{
+  NewTypeHistogram* latency = stats->latency;
+
+  memset(stats, 0, sizeof(*stats));
+  if (latency != NULL) {
+    memset(latency, 0, sizeof(*latency));
+  }
+  stats->latency = latency;
+}
+
+void NewTypeStats_clear(NewTypeStats* stats)
+{
+  PyMem_RawFree(stats->latency);
+  stats->latency = NULL;
+}
+
+PyObject* NewTypeStats_set_enabled(PyObject* module, PyObject* enabled)
+{
+  int r = PyObject_IsTrue(enabled);
+
+  if (r < 0) {
+    return NULL;
+  }
+  return PyBool_FromLong(NEWTYPE_FLAG_SET(NewTypeStats_enabled, r));
+}
+
+PyObject* NewTypeStats_set_latency_enabled(PyObject* module, PyObject* enabled)
+{
+  int r = PyObject_IsTrue(enabled);
+
+  if (r < 0) {
+    return NULL;
+  }
+  return PyBool_FromLong(NEWTYPE_FLAG_SET(NewTypeStats_latency_enabled, r));
+}
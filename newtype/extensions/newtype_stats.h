@@ -0,0 +1,110 @@
+#ifndef NEWTYPE_STATS_H
+#define NEWTYPE_STATS_H
+
+#include <Python.h>
+
+// Buckets of a latency histogram: exact below 4 ns, then 4 per power of two,
+// up to 2**41 ns; each bucket spans at most a quarter of its lower bound
+#define NEWTYPE_HISTOGRAM_BUCKETS 160
+
+typedef struct {
+  unsigned long long counts[NEWTYPE_HISTOGRAM_BUCKETS];
+  unsigned long long max;  // the longest latency recorded, exactly
+} NewTypeHistogram;
+
+// Counters of a `NewTypeMethod` or `NewTypeInit` descriptor, updated while
+// statistics are enabled
+typedef struct {
+  unsigned long long calls;
+  unsigned long long fast_path;  // enum members returned, or calls skipped
+  unsigned long long rewraps;  // results rewrapped into the subtype
+  unsigned long long validations;  // runs of the validator and `__init__`
+  unsigned long long validation_failures;
+  unsigned long long attributes_copied;  // onto rewrapped results
+  // latencies of rewraps, for a `NewTypeMethod`, or of validations, for a
+  // `NewTypeInit`; allocated when the first one is recorded
+  NewTypeHistogram* latency;
+} NewTypeStats;
+
+// An on/off switch read on every call. It is atomic, as free-threaded builds
+// read it in one thread while `newtype.enable_stats()` sets it in another;
+// relaxed loads compile to plain ones.
+#if defined(_MSC_VER) && !defined(__clang__)
+#  include <intrin.h>
+typedef volatile long NewTypeFlag;
+#  define NEWTYPE_FLAG_GET(flag) (flag)
+#  define NEWTYPE_FLAG_SET(flag, value) \
+    ((int)_InterlockedExchange(&(flag), (long)(value)))
+#else
+#  include <stdatomic.h>
+typedef atomic_int NewTypeFlag;
+#  define NEWTYPE_FLAG_GET(flag) \
+    atomic_load_explicit(&(flag), memory_order_relaxed)
+#  define NEWTYPE_FLAG_SET(flag, value) \
+    atomic_exchange_explicit(&(flag), (value), memory_order_relaxed)
+#endif
+
+// Keeps a variable shared by the sources of one extension module out of its
+// exported symbols, so that the two modules never bind to each other's copy
+#if defined(__GNUC__) && !defined(_WIN32)
+#  define NEWTYPE_MODULE_LOCAL __attribute__((visibility("hidden")))
+#else
+#  define NEWTYPE_MODULE_LOCAL
+#endif
+
+// Whether the counters are updated. Each extension module has its own copy,
+// which `newtype.enable_stats()` sets in both.
+extern NEWTYPE_MODULE_LOCAL NewTypeFlag NewTypeStats_enabled;
+// Whether latencies are recorded too, which costs two clock reads each
+extern NEWTYPE_MODULE_LOCAL NewTypeFlag NewTypeStats_latency_enabled;
+
+// While disabled, updating a counter costs this one branch
+#define NEWTYPE_STATS_ADD(stats, field, n)       \
+  do {                                           \
+    if (NEWTYPE_FLAG_GET(NewTypeStats_enabled)) { \
+      (stats).field += (n);                      \
+    }                                            \
+  } while (0)
+
+// Monotonic time in nanoseconds
+unsigned long long NewTypeStats_now(void);
+
+// Returns when the latency being measured started, or 0 if latencies are not
+// being recorded
+#define NEWTYPE_STATS_START() \
+  (NEWTYPE_FLAG_GET(NewTypeStats_latency_enabled) ? NewTypeStats_now() : 0)
+
+// Records the latency of something that started at `start`, as returned by
+// `NEWTYPE_STATS_START()`
+void NewTypeStats_record_latency(NewTypeStats* stats, unsigned long long start);
+
+#define NEWTYPE_STATS_LATENCY(stats, start)          \
+  do {                                               \
+    if ((start) != 0) {                              \
+      NewTypeStats_record_latency(&(stats), (start)); \
+    }                                                \
+  } while (0)
+
+// Returns a new dict of the counters in `stats`
+PyObject* NewTypeStats_as_dict(const NewTypeStats* stats);
+
+// Returns a new list of `(lower ns, upper ns, count)` tuples, one per bucket
+// of the latency histogram of `stats` with a count; the upper bound of the
+// highest one is the longest latency recorded rather than that of its range
+PyObject* NewTypeStats_latency(const NewTypeStats* stats);
+
+// Sets the counters back to zero and empties the histogram
+void NewTypeStats_reset(NewTypeStats* stats);
+
+// Frees the histogram, when the descriptor is deallocated
+void NewTypeStats_clear(NewTypeStats* stats);
+
+// `set_stats_enabled(enabled)` of the extension modules: sets
+// `NewTypeStats_enabled` and returns whether it was set before
+PyObject* NewTypeStats_set_enabled(PyObject* module, PyObject* enabled);
+
+// `set_latency_enabled(enabled)`: the same, for `NewTypeStats_latency_enabled`
+PyObject* NewTypeStats_set_latency_enabled(PyObject* module,
+                                           PyObject* enabled);
+
+#endif  // NEWTYPE_STATS_H
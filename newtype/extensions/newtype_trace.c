@@ -0,0 +1,199 @@
+#define PY_SSIZE_T_CLEAN
+#include "newtype_trace.h"
+
+#include <Python.h>
+#include <pythread.h>
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <pthread.h>
+#endif
+
+#include "newtype_stats.h"
+
+typedef struct {
+  unsigned long long ns;
+  PyTypeObject* type;
+  NewTypeTraceEvent event;
+} NewTypeTraceRecord;
+
+typedef struct NewTypeTraceBuffer {
+  struct NewTypeTraceBuffer* next;
+  unsigned long thread_id;
+  // set when the thread exits, without the GIL; the buffer can then be freed
+  // or handed to another thread
+  NewTypeFlag exited;
+  // records written; the last `NEWTYPE_TRACE_CAPACITY` of them are kept
+  unsigned long long count;
+  NewTypeTraceRecord records[NEWTYPE_TRACE_CAPACITY];
+} NewTypeTraceBuffer;
+
+static const char* NewTypeTrace_event_names[NEWTYPE_TRACE_EVENTS] = {
+    "method_call",
+    "rewrap",
+    "rewrap_fail",
+    "init_call",
+    "init_skip",
+    "init_defer",
+    "validate",
+    "validate_fail",
+};
+
+NewTypeFlag NewTypeTrace_enabled = 0;
+
+// The buffers of all threads, those that have exited included
+static NewTypeTraceBuffer* NewTypeTrace_buffers = NULL;
+
+static NEWTYPE_THREAD_LOCAL NewTypeTraceBuffer* NewTypeTrace_local = NULL;
+
+// Marks the buffer of a thread as exited, from the thread-exit callback
+static void NewTypeTrace_thread_exited(void* buffer)
+{
+  if (buffer != NULL) {
+    NEWTYPE_FLAG_SET(((NewTypeTraceBuffer*)buffer)->exited, 1);
+  }
+}
+
+// A thread-specific slot whose destructor calls `NewTypeTrace_thread_exited`
+// with the buffer of the exiting thread. Without one, buffers are never
+// handed on.
+#ifdef _WIN32
+static DWORD NewTypeTrace_exit_slot = FLS_OUT_OF_INDEXES;
+
+static VOID WINAPI NewTypeTrace_fls_callback(PVOID buffer)
+{
+  NewTypeTrace_thread_exited(buffer);
+}
+
+static void NewTypeTrace_watch_exit(NewTypeTraceBuffer* buffer)
+{
+  if (NewTypeTrace_exit_slot == FLS_OUT_OF_INDEXES) {
+    NewTypeTrace_exit_slot = FlsAlloc(NewTypeTrace_fls_callback);
+  }
+  if (NewTypeTrace_exit_slot != FLS_OUT_OF_INDEXES) {
+    FlsSetValue(NewTypeTrace_exit_slot, buffer);
+  }
+}
+#else
+static pthread_key_t NewTypeTrace_exit_slot;
+static int NewTypeTrace_has_exit_slot = 0;
+
+static void NewTypeTrace_watch_exit(NewTypeTraceBuffer* buffer)
+{
+  if (!NewTypeTrace_has_exit_slot) {
+    NewTypeTrace_has_exit_slot =
+        pthread_key_create(&NewTypeTrace_exit_slot, NewTypeTrace_thread_exited)
+        == 0;
+  }
+  if (NewTypeTrace_has_exit_slot) {
+    pthread_setspecific(NewTypeTrace_exit_slot, buffer);
+  }
+}
+#endif
+
+// Returns the buffer of the current thread. A thread without one takes over
+// the buffer of a thread that has exited, dropping its records, or else gets
+// a new one. Returns NULL if there is no memory for it.
+static NewTypeTraceBuffer* NewTypeTrace_local_buffer(void)
+{
+  NewTypeTraceBuffer* buffer;
+
+  if (NewTypeTrace_local != NULL) {
+    return NewTypeTrace_local;
+  }
+  for (buffer = NewTypeTrace_buffers; buffer != NULL; buffer = buffer->next) {
+    if (NEWTYPE_FLAG_GET(buffer->exited)) {
+      break;
+    }
+  }
+  if (buffer == NULL) {
+    // no exception can be raised from where events are recorded
+    buffer = PyMem_RawMalloc(sizeof(NewTypeTraceBuffer));
+    if (buffer == NULL) {
+      return NULL;
+    }
+    buffer->next = NewTypeTrace_buffers;
+    NewTypeTrace_buffers = buffer;
+  }
+  buffer->thread_id = PyThread_get_thread_ident();
+  NEWTYPE_FLAG_SET(buffer->exited, 0);
+  buffer->count = 0;
+  NewTypeTrace_watch_exit(buffer);
+  NewTypeTrace_local = buffer;
+  return buffer;
+}
+
+void NewTypeTrace_record(NewTypeTraceEvent event, PyTypeObject* type)
+{
+  NewTypeTraceBuffer* buffer = NewTypeTrace_local_buffer();
+  NewTypeTraceRecord* record;
+
+  if (buffer == NULL) {
+    return;
+  }
+  record = &buffer->records[buffer->count & (NEWTYPE_TRACE_CAPACITY - 1)];
+  record->ns = NewTypeStats_now();
+  record->type = type;
+  record->event = event;
+  buffer->count++;
+}
+
+PyObject* NewTypeTrace_set_enabled(PyObject* module, PyObject* enabled)
+{
+  int r = PyObject_IsTrue(enabled);
+
+  if (r < 0) {
+    return NULL;
+  }
+  return PyBool_FromLong(NEWTYPE_FLAG_SET(NewTypeTrace_enabled, r));
+}
+
+PyObject* NewTypeTrace_records(PyObject* module, PyObject* Py_UNUSED(ignored))
+{
+  NewTypeTraceBuffer* buffer;
+  unsigned long long i, first;
+  PyObject *records = PyList_New(0), *item;
+
+  if (records == NULL) {
+    return NULL;
+  }
+  for (buffer = NewTypeTrace_buffers; buffer != NULL; buffer = buffer->next) {
+    first = buffer->count > NEWTYPE_TRACE_CAPACITY
+        ? buffer->count - NEWTYPE_TRACE_CAPACITY
+        : 0;
+    for (i = first; i < buffer->count; i++) {
+      NewTypeTraceRecord* record =
+          &buffer->records[i & (NEWTYPE_TRACE_CAPACITY - 1)];
+      item = Py_BuildValue("(kKsN)",
+                           buffer->thread_id,
+                           record->ns,
+                           NewTypeTrace_event_names[record->event],
+                           PyLong_FromVoidPtr(record->type));
+      if (item == NULL || PyList_Append(records, item) < 0) {
+        Py_XDECREF(item);
+        Py_DECREF(records);
+        return NULL;
+      }
+      Py_DECREF(item);
+    }
+  }
+  return records;
+}
+
+PyObject* NewTypeTrace_clear(PyObject* module, PyObject* Py_UNUSED(ignored))
+{
+  NewTypeTraceBuffer **link = &NewTypeTrace_buffers, *buffer;
+
+  // the buffers of live threads stay theirs, as they keep pointing to them
+  while ((buffer = *link) != NULL) {
+    if (NEWTYPE_FLAG_GET(buffer->exited)) {
+      *link = buffer->next;
+      PyMem_RawFree(buffer);
+    } else {
+      buffer->count = 0;
+      link = &buffer->next;
+    }
+  }
+  Py_RETURN_NONE;
+}
@@ -0,0 +1,68 @@
+#ifndef NEWTYPE_TRACE_H
+#define NEWTYPE_TRACE_H
+
+#include <Python.h>
+
+#include "newtype_stats.h"
+
+// Events recorded in the trace buffers; `NewTypeTrace_event_names` has their
+// names, in the same order
+typedef enum {
+  NEWTYPE_TRACE_METHOD_CALL,
+  NEWTYPE_TRACE_REWRAP,  // a result rewrapped into the subtype
+  NEWTYPE_TRACE_REWRAP_FAIL,
+  NEWTYPE_TRACE_INIT_CALL,
+  NEWTYPE_TRACE_INIT_SKIP,  // an interned instance, initialised already
+  NEWTYPE_TRACE_INIT_DEFER,  // a lazy instance, validated on first use
+  NEWTYPE_TRACE_VALIDATE,
+  NEWTYPE_TRACE_VALIDATE_FAIL,
+  NEWTYPE_TRACE_EVENTS
+} NewTypeTraceEvent;
+
+// Storage class of variables with a value per thread
+#ifdef _WIN32
+#  define NEWTYPE_THREAD_LOCAL __declspec(thread)
+#else
+#  define NEWTYPE_THREAD_LOCAL __thread
+#endif
+
+// Records kept per thread; a power of two. Older records are overwritten.
+#define NEWTYPE_TRACE_CAPACITY 4096
+
+// Whether events are recorded. Each extension module has its own copy, and
+// its own buffers, which `newtype.enable_trace()` and `newtype.trace_dump()`
+// handle together.
+//
+// The buffers are not lock-free: a thread writes its own buffer, but the list
+// of buffers, and the records `trace_dump()` reads, are guarded by the GIL,
+// which every recording site holds. A thread that exits hands its buffer on
+// to the next thread that needs one, so the buffers never outnumber the
+// threads that were recording at the same time.
+extern NEWTYPE_MODULE_LOCAL NewTypeFlag NewTypeTrace_enabled;
+
+// Appends a record of `event` about `type` to the buffer of the current
+// thread. Only the address of `type` is kept: `newtype.trace_dump()` names the
+// types that are still alive.
+void NewTypeTrace_record(NewTypeTraceEvent event, PyTypeObject* type);
+
+// While disabled, tracing an event costs this one branch
+#define NEWTYPE_TRACE(event, type)                \
+  do {                                            \
+    if (NEWTYPE_FLAG_GET(NewTypeTrace_enabled)) { \
+      NewTypeTrace_record((event), (type));       \
+    }                                             \
+  } while (0)
+
+// `set_trace_enabled(enabled)` of the extension modules: sets
+// `NewTypeTrace_enabled` and returns whether it was set before
+PyObject* NewTypeTrace_set_enabled(PyObject* module, PyObject* enabled);
+
+// `trace_records()`: returns a new list of `(thread id, ns, event name, type
+// address)` tuples, the records of each thread oldest first
+PyObject* NewTypeTrace_records(PyObject* module, PyObject* Py_UNUSED(ignored));
+
+// `trace_clear()`: drops all the records, and frees the buffers of the threads
+// that have exited
+PyObject* NewTypeTrace_clear(PyObject* module, PyObject* Py_UNUSED(ignored));
+
+#endif  // NEWTYPE_TRACE_H
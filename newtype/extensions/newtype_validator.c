@@ -0,0 +1,561 @@
+#define PY_SSIZE_T_CLEAN
+#include "newtype_validator.h"
+
+#include <Python.h>
+#include <pythread.h>
+#include <stddef.h>
+#include <string.h>
+#ifndef _WIN32
+#  include <unistd.h>
+#endif
+
+#include "newtype_debug_print.h"
+#include "structmember.h"
+
+// A value reduced to what the kernel needs, so that it can be inspected
+// without touching any Python object; `kind` is -1 for unsupported types
+typedef struct {
+  int kind;
+  const void* data;
+  Py_ssize_t len;
+} NativeValidatorItem;
+
+// A contiguous slice of the batch handed to one OS thread
+typedef struct {
+  const NativeValidatorObject* validator;
+  const NativeValidatorItem* items;
+  unsigned char* status;
+  Py_ssize_t start;
+  Py_ssize_t stop;
+} NativeValidatorChunk;
+
+// A thread of the pool. It waits on `start` for a chunk and releases `done`
+// once the chunk is validated; both locks are held while it is idle.
+typedef struct {
+  PyThread_type_lock start;
+  PyThread_type_lock done;
+  NativeValidatorChunk* chunk;
+} NativeValidatorWorker;
+
+// The pool shared by all validators. Its threads are started on demand, up to
+// `NEWTYPE_VALIDATOR_MAX_WORKERS`, and then kept for the life of the process;
+// they never touch the Python C-API, so they need no thread state. `busy` is
+// held by the batch using the pool, as a batch hands chunks to every worker.
+static NativeValidatorWorker
+    NativeValidator_workers[NEWTYPE_VALIDATOR_MAX_WORKERS];
+static Py_ssize_t NativeValidator_n_workers = 0;
+static PyThread_type_lock NativeValidator_busy = NULL;
+#ifndef _WIN32
+// The threads of the pool do not survive a `fork()`; the child starts its own
+static pid_t NativeValidator_pool_pid = 0;
+#endif
+
+static int NativeValidator_extract(PyObject* value, NativeValidatorItem* item)
+{
+  if (PyUnicode_Check(value)) {
+#if PY_VERSION_HEX < 0x030C0000
+    if (PyUnicode_READY(value) < 0) {
+      return -1;
+    }
+#endif
+    item->kind = PyUnicode_KIND(value);
+    item->data = PyUnicode_DATA(value);
+    item->len = PyUnicode_GET_LENGTH(value);
+  } else if (PyBytes_Check(value)) {
+    item->kind = PyUnicode_1BYTE_KIND;
+    item->data = PyBytes_AS_STRING(value);
+    item->len = PyBytes_GET_SIZE(value);
+  } else {
+    item->kind = -1;
+    item->data = NULL;
+    item->len = 0;
+  }
+  return 0;
+}
+
+// Returns the position of the first character outside the charset, or -1
+static Py_ssize_t NativeValidator_find_bad_char(
+    const NativeValidatorObject* self, const NativeValidatorItem* item)
+{
+  Py_ssize_t i;
+  Py_UCS4 ch;
+
+  for (i = 0; i < item->len; i++) {
+    switch (item->kind) {
+      case PyUnicode_1BYTE_KIND:
+        ch = ((const Py_UCS1*)item->data)[i];
+        break;
+      case PyUnicode_2BYTE_KIND:
+        ch = ((const Py_UCS2*)item->data)[i];
+        break;
+      default:
+        ch = ((const Py_UCS4*)item->data)[i];
+        break;
+    }
+    if (ch >= 128 || !self->charset[ch]) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// The kernel itself; must never touch the Python C-API as it runs without
+// the GIL
+static NativeValidatorStatus NativeValidator_kernel(
+    const NativeValidatorObject* self, const NativeValidatorItem* item)
+{
+  if (item->kind < 0) {
+    return NATIVE_VALIDATOR_BAD_TYPE;
+  }
+  if (item->len < self->min_len) {
+    return NATIVE_VALIDATOR_TOO_SHORT;
+  }
+  if (self->max_len >= 0 && item->len > self->max_len) {
+    return NATIVE_VALIDATOR_TOO_LONG;
+  }
+  if (self->has_charset && NativeValidator_find_bad_char(self, item) >= 0) {
+    return NATIVE_VALIDATOR_BAD_CHAR;
+  }
+  return NATIVE_VALIDATOR_OK;
+}
+
+static void NativeValidator_run_chunk(void* arg)
+{
+  NativeValidatorChunk* chunk = (NativeValidatorChunk*)arg;
+
+  for (Py_ssize_t i = chunk->start; i < chunk->stop; i++) {
+    chunk->status[i] =
+        (unsigned char)NativeValidator_kernel(chunk->validator, &chunk->items[i]);
+  }
+}
+
+static void NativeValidator_work(void* arg)
+{
+  NativeValidatorWorker* worker = (NativeValidatorWorker*)arg;
+
+  for (;;) {
+    PyThread_acquire_lock(worker->start, WAIT_LOCK);
+    NativeValidator_run_chunk(worker->chunk);
+    PyThread_release_lock(worker->done);
+  }
+}
+
+// Creates the lock of the pool, and forgets the threads of the parent process
+// in a forked child; called with the GIL held
+static int NativeValidator_pool_init(void)
+{
+#ifndef _WIN32
+  if (NativeValidator_busy != NULL && NativeValidator_pool_pid != getpid()) {
+    // the locks may have been held by threads that no longer exist
+    NativeValidator_busy = NULL;
+    NativeValidator_n_workers = 0;
+  }
+  NativeValidator_pool_pid = getpid();
+#endif
+  if (NativeValidator_busy == NULL) {
+    NativeValidator_busy = PyThread_allocate_lock();
+    if (NativeValidator_busy == NULL) {
+      PyErr_NoMemory();
+      return -1;
+    }
+  }
+  return 0;
+}
+
+// Makes sure that the pool has `n` threads, starting the missing ones; returns
+// how many it has, which is fewer if a thread could not be started. Called
+// with `NativeValidator_busy` held.
+static Py_ssize_t NativeValidator_pool_grow(Py_ssize_t n)
+{
+  while (NativeValidator_n_workers < n) {
+    NativeValidatorWorker* worker =
+        &NativeValidator_workers[NativeValidator_n_workers];
+
+    worker->start = PyThread_allocate_lock();
+    worker->done = PyThread_allocate_lock();
+    if (worker->start != NULL && worker->done != NULL) {
+      PyThread_acquire_lock(worker->start, WAIT_LOCK);
+      PyThread_acquire_lock(worker->done, WAIT_LOCK);
+      if (PyThread_start_new_thread(NativeValidator_work, worker)
+          != PYTHREAD_INVALID_THREAD_ID)
+      {
+        NativeValidator_n_workers++;
+        continue;
+      }
+      PyThread_release_lock(worker->start);
+      PyThread_release_lock(worker->done);
+    }
+    if (worker->start != NULL) {
+      PyThread_free_lock(worker->start);
+    }
+    if (worker->done != NULL) {
+      PyThread_free_lock(worker->done);
+    }
+    break;
+  }
+  return NativeValidator_n_workers;
+}
+
+// Sets the exception for a failed value; `index` is -1 outside of a batch
+static void NativeValidator_set_error(NativeValidatorObject* self,
+                                      NativeValidatorStatus status,
+                                      PyObject* value,
+                                      const NativeValidatorItem* item,
+                                      Py_ssize_t index)
+{
+  PyObject* exc_type = PyExc_ValueError;
+  PyObject* msg = NULL;
+  Py_ssize_t pos;
+
+  switch (status) {
+    case NATIVE_VALIDATOR_TOO_SHORT:
+      msg = PyUnicode_FromFormat(
+          "%R is shorter than `min_len` = %zd", value, self->min_len);
+      break;
+    case NATIVE_VALIDATOR_TOO_LONG:
+      msg = PyUnicode_FromFormat(
+          "%R is longer than `max_len` = %zd", value, self->max_len);
+      break;
+    case NATIVE_VALIDATOR_BAD_CHAR:
+      pos = NativeValidator_find_bad_char(self, item);
+      msg = PyUnicode_FromFormat(
+          "%R contains a character outside of `charset` at position %zd",
+          value,
+          pos);
+      break;
+    default:
+      exc_type = PyExc_TypeError;
+      msg = PyUnicode_FromFormat("expected `str` or `bytes`, got `%s`",
+                                 Py_TYPE(value)->tp_name);
+      break;
+  }
+  if (msg == NULL) {
+    return;
+  }
+  if (index >= 0) {
+    PyErr_Format(exc_type, "`values[%zd]`: %U", index, msg);
+  } else {
+    PyErr_SetObject(exc_type, msg);
+  }
+  Py_DECREF(msg);
+}
+
+int NativeValidator_validate(NativeValidatorObject* self, PyObject* value)
+{
+  NativeValidatorItem item;
+  NativeValidatorStatus status;
+
+  if (NativeValidator_extract(value, &item) < 0) {
+    return -1;
+  }
+  status = NativeValidator_kernel(self, &item);
+  if (status != NATIVE_VALIDATOR_OK) {
+    NativeValidator_set_error(self, status, value, &item, -1);
+    return -1;
+  }
+  return 0;
+}
+
+int NativeValidator_validate_many(NativeValidatorObject* self,
+                                  PyObject* seq,
+                                  Py_ssize_t workers)
+{
+  PyObject* snapshot;
+  PyObject** values;
+  NativeValidatorItem* items = NULL;
+  unsigned char* status = NULL;
+  NativeValidatorChunk* chunks = NULL;
+  Py_ssize_t n, n_chunks, chunk_len, i;
+  int ret = -1;
+
+  // A tuple snapshot keeps every value alive while the GIL is released, even
+  // if another thread mutates the list we were given
+  snapshot = PySequence_Tuple(seq);
+  if (snapshot == NULL) {
+    return -1;
+  }
+  n = PyTuple_GET_SIZE(snapshot);
+  values = &PyTuple_GET_ITEM(snapshot, 0);
+  if (n == 0) {
+    Py_DECREF(snapshot);
+    return 0;
+  }
+
+  items = PyMem_Malloc(n * sizeof(NativeValidatorItem));
+  status = PyMem_Calloc(n, sizeof(unsigned char));
+  if (items == NULL || status == NULL) {
+    PyErr_NoMemory();
+    goto done;
+  }
+  for (i = 0; i < n; i++) {
+    if (NativeValidator_extract(values[i], &items[i]) < 0) {
+      goto done;
+    }
+  }
+
+  if (workers < 1) {
+    workers = 1;
+  }
+  // the calling thread is one of the workers
+  if (workers > NEWTYPE_VALIDATOR_MAX_WORKERS + 1) {
+    workers = NEWTYPE_VALIDATOR_MAX_WORKERS + 1;
+  }
+  n_chunks = n / NEWTYPE_VALIDATOR_MIN_CHUNK;
+  if (n_chunks > workers) {
+    n_chunks = workers;
+  }
+  if (n_chunks < 1) {
+    n_chunks = 1;
+  }
+  chunk_len = (n + n_chunks - 1) / n_chunks;
+  chunks = PyMem_Calloc(n_chunks, sizeof(NativeValidatorChunk));
+  if (chunks == NULL) {
+    PyErr_NoMemory();
+    goto done;
+  }
+  if (n_chunks > 1 && NativeValidator_pool_init() < 0) {
+    goto done;
+  }
+  for (i = 0; i < n_chunks; i++) {
+    chunks[i].validator = self;
+    chunks[i].items = items;
+    chunks[i].status = status;
+    chunks[i].start = i * chunk_len;
+    chunks[i].stop = (i + 1) * chunk_len < n ? (i + 1) * chunk_len : n;
+  }
+  DEBUG_PRINT("validating %zd values in %zd chunks\n", n, n_chunks);
+
+  Py_BEGIN_ALLOW_THREADS
+  if (n_chunks == 1) {
+    NativeValidator_run_chunk(&chunks[0]);
+  } else {
+    Py_ssize_t n_workers;
+
+    // batches running at the same time take turns with the pool
+    PyThread_acquire_lock(NativeValidator_busy, WAIT_LOCK);
+    n_workers = NativeValidator_pool_grow(n_chunks - 1);
+    for (i = 0; i < n_workers && i + 1 < n_chunks; i++) {
+      NativeValidator_workers[i].chunk = &chunks[i + 1];
+      PyThread_release_lock(NativeValidator_workers[i].start);
+    }
+    // the calling thread takes the first chunk, and those left without a
+    // worker, itself
+    NativeValidator_run_chunk(&chunks[0]);
+    for (i = n_workers + 1; i < n_chunks; i++) {
+      NativeValidator_run_chunk(&chunks[i]);
+    }
+    for (i = 0; i < n_workers && i + 1 < n_chunks; i++) {
+      PyThread_acquire_lock(NativeValidator_workers[i].done, WAIT_LOCK);
+    }
+    PyThread_release_lock(NativeValidator_busy);
+  }
+  Py_END_ALLOW_THREADS
+
+  for (i = 0; i < n; i++) {
+    if (status[i] != NATIVE_VALIDATOR_OK) {
+      NativeValidator_set_error(self,
+                                (NativeValidatorStatus)status[i],
+                                values[i],
+                                &items[i],
+                                i);
+      goto done;
+    }
+  }
+  ret = 0;
+
+done:
+  PyMem_Free(chunks);
+  PyMem_Free(status);
+  PyMem_Free(items);
+  Py_DECREF(snapshot);
+  return ret;
+}
+
+// The configuration is set here rather than in `__init__`, so that it cannot
+// change while a batch reads it with the GIL released
+static PyObject* NativeValidator_new(PyTypeObject* type,
+                                     PyObject* args,
+                                     PyObject* kwds)
+{
+  static char* kwlist[] = {"min_len", "max_len", "charset", NULL};
+  NativeValidatorObject* self;
+  Py_ssize_t min_len = 0;
+  PyObject* max_len = Py_None;
+  PyObject* charset = Py_None;
+
+  if (!PyArg_ParseTupleAndKeywords(
+          args, kwds, "|$nOO", kwlist, &min_len, &max_len, &charset))
+  {
+    return NULL;
+  }
+
+  self = (NativeValidatorObject*)type->tp_alloc(type, 0);
+  if (self == NULL) {
+    return NULL;
+  }
+
+  if (min_len < 0) {
+    PyErr_SetString(PyExc_ValueError, "`min_len` must not be negative");
+    goto error;
+  }
+  self->min_len = min_len;
+
+  if (max_len == Py_None) {
+    self->max_len = -1;
+  } else {
+    self->max_len = PyNumber_AsSsize_t(max_len, PyExc_OverflowError);
+    if (self->max_len == -1 && PyErr_Occurred()) {
+      goto error;
+    }
+    if (self->max_len < min_len) {
+      PyErr_SetString(PyExc_ValueError,
+                      "`max_len` must not be smaller than `min_len`");
+      goto error;
+    }
+  }
+
+  memset(self->charset, 0, sizeof(self->charset));
+  self->has_charset = 0;
+  if (charset != Py_None) {
+    if (!PyUnicode_Check(charset)) {
+      PyErr_SetString(PyExc_TypeError, "`charset` must be a `str` or `None`");
+      goto error;
+    }
+    Py_ssize_t len = PyUnicode_GetLength(charset);
+    for (Py_ssize_t i = 0; i < len; i++) {
+      Py_UCS4 ch = PyUnicode_ReadChar(charset, i);
+      if (ch >= 128) {
+        PyErr_SetString(PyExc_ValueError,
+                        "`charset` may only contain ASCII characters");
+        goto error;
+      }
+      self->charset[ch] = 1;
+    }
+    self->has_charset = 1;
+  }
+  Py_INCREF(charset);
+  self->charset_obj = charset;
+
+  return (PyObject*)self;
+
+error:
+  Py_DECREF(self);
+  return NULL;
+}
+
+// Accepts the call `type.__call__` makes after `NativeValidator_new`, and
+// rejects any later one rather than silently ignoring its arguments
+static int NativeValidator_init(NativeValidatorObject* self,
+                                PyObject* args,
+                                PyObject* kwds)
+{
+  if (self->initialized) {
+    PyErr_SetString(PyExc_TypeError,
+                    "`NativeValidator` is immutable and cannot be "
+                    "reinitialised");
+    return -1;
+  }
+  self->initialized = 1;
+  return 0;
+}
+
+static PyObject* NativeValidator_call(NativeValidatorObject* self,
+                                      PyObject* args,
+                                      PyObject* kwds)
+{
+  PyObject* value;
+
+  if (!PyArg_ParseTuple(args, "O", &value)) {
+    return NULL;
+  }
+  if (NativeValidator_validate(self, value) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+static PyObject* NativeValidator_validate_many_meth(NativeValidatorObject* self,
+                                                    PyObject* args,
+                                                    PyObject* kwds)
+{
+  static char* kwlist[] = {"values", "workers", NULL};
+  PyObject* values;
+  Py_ssize_t workers = 1;
+
+  if (!PyArg_ParseTupleAndKeywords(
+          args, kwds, "O|n", kwlist, &values, &workers))
+  {
+    return NULL;
+  }
+  if (NativeValidator_validate_many(self, values, workers) < 0) {
+    return NULL;
+  }
+  Py_RETURN_NONE;
+}
+
+static PyObject* NativeValidator_get_max_len(NativeValidatorObject* self,
+                                             void* closure)
+{
+  if (self->max_len < 0) {
+    Py_RETURN_NONE;
+  }
+  return PyLong_FromSsize_t(self->max_len);
+}
+
+static PyObject* NativeValidator_repr(NativeValidatorObject* self)
+{
+  PyObject* max_len = NativeValidator_get_max_len(self, NULL);
+  PyObject* repr;
+
+  if (max_len == NULL) {
+    return NULL;
+  }
+  repr = PyUnicode_FromFormat("NativeValidator(min_len=%zd, max_len=%R, "
+                              "charset=%R)",
+                              self->min_len,
+                              max_len,
+                              self->charset_obj ? self->charset_obj : Py_None);
+  Py_DECREF(max_len);
+  return repr;
+}
+
+static void NativeValidator_dealloc(NativeValidatorObject* self)
+{
+  Py_XDECREF(self->charset_obj);
+  Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyMethodDef NativeValidator_methods[] = {
+    {"validate_many",
+     (PyCFunction)(void (*)(void))NativeValidator_validate_many_meth,
+     METH_VARARGS | METH_KEYWORDS,
+     "Validate every value of a sequence, releasing the GIL and using up to "
+     "`workers` threads."},
+    {NULL, NULL, 0, NULL}};
+
+static PyMemberDef NativeValidator_members[] = {
+    {"min_len", T_PYSSIZET, offsetof(NativeValidatorObject, min_len), READONLY},
+    {"charset", T_OBJECT, offsetof(NativeValidatorObject, charset_obj), READONLY},
+    {0}};
+
+static PyGetSetDef NativeValidator_getset[] = {
+    {"max_len", (getter)NativeValidator_get_max_len, NULL, NULL, NULL},
+    {NULL}};
+
+PyTypeObject NativeValidatorType = {
+    PyVarObject_HEAD_INIT(NULL, 0).tp_name = "newtypeinit.NativeValidator",
+    .tp_doc =
+        "Validator for `str` and `bytes` values implemented in C, so that "
+        "batches of values can be validated without holding the GIL.",
+    .tp_basicsize = sizeof(NativeValidatorObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = NativeValidator_new,
+    .tp_init = (initproc)NativeValidator_init,
+    .tp_dealloc = (destructor)NativeValidator_dealloc,
+    .tp_call = (ternaryfunc)NativeValidator_call,
+    .tp_repr = (reprfunc)NativeValidator_repr,
+    .tp_methods = NativeValidator_methods,
+    .tp_members = NativeValidator_members,
+    .tp_getset = NativeValidator_getset,
+};
@@ -0,0 +1,46 @@
+#ifndef NEWTYPE_VALIDATOR_H
+#define NEWTYPE_VALIDATOR_H
+
+#include <Python.h>
+
+// Below this many items per worker, handing out chunks costs more than it saves
+#define NEWTYPE_VALIDATOR_MIN_CHUNK 4096
+// Threads in the pool of `NativeValidator_validate_many`, at most
+#define NEWTYPE_VALIDATOR_MAX_WORKERS 64
+
+// Outcome of running the native kernel over a single value
+typedef enum {
+  NATIVE_VALIDATOR_OK = 0,
+  NATIVE_VALIDATOR_TOO_SHORT,
+  NATIVE_VALIDATOR_TOO_LONG,
+  NATIVE_VALIDATOR_BAD_CHAR,
+  NATIVE_VALIDATOR_BAD_TYPE,
+} NativeValidatorStatus;
+
+// Structure definition for NativeValidatorObject
+typedef struct {
+  PyObject_HEAD Py_ssize_t min_len;
+  Py_ssize_t max_len;  // -1 means unbounded
+  int has_charset;
+  unsigned char charset[128];  // allowed ASCII code points
+  PyObject* charset_obj;
+  int initialized;  // set by the one `__init__` call that is allowed
+} NativeValidatorObject;
+
+extern PyTypeObject NativeValidatorType;
+
+#define NativeValidator_Check(op) PyObject_TypeCheck(op, &NativeValidatorType)
+
+// Validates `value` with the GIL held; sets `ValueError`/`TypeError` and
+// returns -1 on failure
+int NativeValidator_validate(NativeValidatorObject* self, PyObject* value);
+
+// Validates every item of `seq` (a list or tuple), splitting the work across
+// the calling thread and `workers - 1` threads of a pool started once per
+// process, with the GIL released; on failure the error raised refers to the
+// lowest failing index, whatever the thread scheduling
+int NativeValidator_validate_many(NativeValidatorObject* self,
+                                  PyObject* seq,
+                                  Py_ssize_t workers);
+
+#endif  // NEWTYPE_VALIDATOR_H
@@ -22,13 +22,158 @@ The initialization of SafeStr is handled by NewTypeInit, which ensures that:
 3. All string operations return SafeStr instances
 """
 
-from typing import Any, Callable, Optional, Type, TypeVar, overload
+from typing import Any, Callable, Iterable, MutableMapping, Optional, Type, TypeVar, overload
 
+NEWTYPE_FREELIST_STR: str
 NEWTYPE_INIT_ARGS_STR: str
 NEWTYPE_INIT_KWARGS_STR: str
+NEWTYPE_PENDING_STR: str
 
 T = TypeVar("T")
 
+class NativeValidator:
+    """Validator for `str` and `bytes` values implemented in C.
+
+    Because the checks never touch Python objects, batches of values can be
+    validated with the GIL released, split across several threads.
+
+    Args:
+        min_len: The minimum length, in code points for `str` and bytes for `bytes`
+        max_len: The maximum length, or `None` for no limit
+        charset: If given, the only (ASCII) characters a value may contain
+
+    A validator cannot be changed once created: calling `__init__` again raises
+    `TypeError`.
+
+    Example:
+        ```python
+        class UserId(NewType(str), validator=NativeValidator(max_len=32, charset=ALNUM)): ...
+
+        ids = UserId.batch(raw_ids)  # validated on all CPUs
+        ```
+    """
+
+    min_len: int
+    max_len: int | None
+    charset: str | None
+
+    def __init__(
+        self, *, min_len: int = 0, max_len: int | None = None, charset: str | None = None
+    ) -> None: ...
+    def __call__(self, value: Any) -> None:
+        """Validate a single value, raising `ValueError` (or `TypeError`) if invalid."""
+        ...
+
+    def validate_many(self, values: Iterable[Any], workers: int = 1) -> None:
+        """Validate every value with the GIL released, using up to `workers` threads.
+
+        The calling thread is one of them; the others come from a pool of up to
+        64 threads, started on first use and kept for the life of the process.
+        The error raised always refers to the lowest failing index.
+        """
+        ...
+
+def construct_many(cls: type[T], values: Iterable[Any], workers: int = 1) -> list[T]:
+    """Construct an instance of `cls` for every value, preserving order.
+
+    If `cls` has a native validator, all values are validated first on up to
+    `workers` threads with the GIL released; the instances are then built on
+    the calling thread by calling `cls`, metaclass included, without validating
+    natively again.
+    """
+    ...
+
+def set_freelist(cls: type, capacity: int) -> None:
+    """Keep up to `capacity` deallocated instances of `cls` for reuse.
+
+    The next allocations of `cls` take their memory from the instances kept. A
+    `capacity` of 0 releases them and stops keeping any. The free-list is kept under
+    `NEWTYPE_FREELIST_STR` in the `__dict__` of `cls`, is not used by its subclasses,
+    and is released with `cls`. Raises `TypeError` if the instances of `cls` vary in
+    size, as those of `int` and `str` do.
+    """
+    ...
+
+def freelist_stats(cls: type) -> dict[str, int | float] | None:
+    """Return the counters of the free-list of `cls`, or None if it has none.
+
+    The keys are `capacity`, `size`, `hits` and `misses` (allocations served from
+    the free-list or not), `kept` and `released` (deallocations added to it or
+    not), and `hit_rate`.
+    """
+    ...
+
+def set_stats_enabled(enabled: bool) -> bool:
+    """Make the `NewTypeInit`s keep counters or not; returns whether they did."""
+    ...
+
+def set_latency_enabled(enabled: bool) -> bool:
+    """Make the `NewTypeInit`s record the latencies of validations or not; returns whether they did."""
+    ...
+
+def set_trace_enabled(enabled: bool) -> bool:
+    """Make the `NewTypeInit`s record trace events or not; returns whether they did."""
+    ...
+
+def trace_records() -> list[tuple[int, int, str, int]]:
+    """Return the trace records of the `NewTypeInit`s.
+
+    Each is a `(thread id, ns, event, type address)` tuple; the records of each
+    thread are oldest first.
+    """
+    ...
+
+def trace_clear() -> None:
+    """Drop the trace records of the `NewTypeInit`s."""
+    ...
+
+def count_allocations(func: Callable[[], Any], number: int = 1) -> tuple[int, int]:
+    """Call `func()` `number` times, counting the requests to the allocators.
+
+    Counts the calls to the object and memory (`PyMem`) allocators, not the raw
+    one, while `func` runs, including freeing its results. Returns
+    `(allocations, frees)`, where a reallocation counts as both.
+    """
+    ...
+
+def instantiate(cls: type[T], args: Any) -> type[T]:
+    """Return `cls[args]` for a parameterised NewType `cls`.
+
+    The instantiation is the subclass of `cls` setting each of its parameters to the
+    matching argument. It is created on first use and kept, by weak reference, in a
+    table on `cls`, so later subscripts with equal arguments return the same class.
+    """
+    ...
+
+def unsafe_cast(cls: type[T], value: Any) -> T:
+    """Build an instance of `cls` around an already-valid `value`.
+
+    Neither the native validator nor `__init__` run. Under `python -X dev`, or with
+    `NEWTYPE_CHECK_UNSAFE_CAST` set in the environment, this calls `cls(value)`.
+    """
+    ...
+
+def unwrap(value: Any) -> Any:
+    """Return `value` as an instance of its exact base type.
+
+    A `NewType(str)` instance gives an exact `str` with the same contents. NewTypes of
+    classes with a `__new__` of their own are unwrapped by calling the class on the
+    value, which raises `TypeError` if that does not return an exact instance. Exact
+    instances, and values of other classes, are returned as they are.
+    """
+    ...
+
+def unwrap_many(values: Iterable[Any]) -> list[Any]:
+    """Return a list with every value unwrapped as by `unwrap`."""
+    ...
+
+def validate_pending(inst: Any) -> None:
+    """Run the validation deferred by a lazy NewType on `inst`, if any.
+
+    The pending `(args, kwargs)` record is restored if validation fails.
+    """
+    ...
+
 class NewTypeInit:
     """Descriptor class for handling NewType subclass initialization.
 
@@ -39,6 +184,7 @@ class NewTypeInit:
     Args:
         func (Callable[..., Any]): The initialization function to be wrapped,
             typically the __init__ method of the NewType subclass.
+        validator (Optional[NativeValidator]): Run on the value before `func`.
 
     Attributes
     ----------
@@ -48,7 +194,14 @@ class NewTypeInit:
         cls: The class being initialized
     """
 
-    def __init__(self, func: Callable[..., Any]) -> None: ...
+    def __init__(
+        self,
+        func: Callable[..., Any],
+        validator: NativeValidator | None = None,
+        *,
+        lazy: bool = False,
+        pool: MutableMapping[Any, Any] | None = None,
+    ) -> None: ...
     def __get__(self, inst: Any | None, owner: type[Any] | None) -> NewTypeInit:
         """Implement the descriptor protocol for method binding.
 
@@ -83,3 +236,19 @@ class NewTypeInit:
             A properly initialized instance of the NewType subclass
         """
         ...
+
+    def stats(self) -> dict[str, int]:
+        """Return the counters of the constructor, kept while statistics are enabled."""
+        ...
+
+    def latency(self) -> list[tuple[int, int, int]]:
+        """Return the histogram of the latencies of the validations of the constructor.
+
+        Each bucket with a count is a `(lower ns, upper ns, count)` tuple. The upper
+        bound of the highest bucket is the longest latency recorded.
+        """
+        ...
+
+    def reset_stats(self) -> None:
+        """Set the counters of the constructor back to zero."""
+        ...
@@ -21,10 +21,43 @@ In this example, NewTypeMethod ensures that the upper() method returns a SafeStr
 instance instead of a regular str, maintaining type safety throughout the operation.
 """
 
+from contextvars import Token
 from typing import Any, Callable, Optional, Type, TypeVar, overload
 
 T = TypeVar("T")
 
+def raw_enter() -> Token[bool]:
+    """Make `NewTypeMethod`s return unwrapped results in the current context."""
+    ...
+
+def raw_exit(token: Token[bool]) -> None:
+    """Undo the matching `raw_enter`."""
+    ...
+
+def set_stats_enabled(enabled: bool) -> bool:
+    """Make the `NewTypeMethod`s keep counters or not; returns whether they did."""
+    ...
+
+def set_latency_enabled(enabled: bool) -> bool:
+    """Make the `NewTypeMethod`s record the latencies of rewraps or not; returns whether they did."""
+    ...
+
+def set_trace_enabled(enabled: bool) -> bool:
+    """Make the `NewTypeMethod`s record trace events or not; returns whether they did."""
+    ...
+
+def trace_records() -> list[tuple[int, int, str, int]]:
+    """Return the trace records of the `NewTypeMethod`s.
+
+    Each is a `(thread id, ns, event, type address)` tuple; the records of each
+    thread are oldest first.
+    """
+    ...
+
+def trace_clear() -> None:
+    """Drop the trace records of the `NewTypeMethod`s."""
+    ...
+
 class NewTypeMethod:
     """Descriptor class for handling NewType subclass method calls.
 
@@ -35,6 +68,10 @@ class NewTypeMethod:
     Args:
         func (Callable[..., Any]): The method to be wrapped
         wrapped_cls (Type[Any]): The NewType subclass that owns this method
+        lazy: Validate a pending receiver before calling through
+        invariant: Rewrap results without running `__init__` again
+        rewrap: Rewrap results of the wrapped type; false for methods such as
+            `__hash__`, whose results are plain values whatever their type
 
     Attributes
     ----------
@@ -43,9 +80,20 @@ class NewTypeMethod:
         obj: The instance the method is bound to (None for unbound calls)
         cls: The class that owns this method
         wrapped_cls: The NewType subclass this method belongs to
+        rewraps: The results rewrapped while statistics were enabled
     """
 
-    def __init__(self, func: Callable[..., Any], wrapped_cls: type[Any]) -> None: ...
+    cls: type[Any] | None
+    rewraps: int
+    def __init__(
+        self,
+        func: Callable[..., Any],
+        wrapped_cls: type[Any],
+        *,
+        lazy: bool = False,
+        invariant: bool = False,
+        rewrap: bool = True,
+    ) -> None: ...
     def __get__(self, inst: Any | None, owner: type[Any] | None) -> NewTypeMethod:
         """Implement the descriptor protocol for method binding.
 
@@ -80,3 +128,19 @@ class NewTypeMethod:
             The result of the method call, properly typed as the NewType subclass
         """
         ...
+
+    def stats(self) -> dict[str, int]:
+        """Return the counters of the method, kept while statistics are enabled."""
+        ...
+
+    def latency(self) -> list[tuple[int, int, int]]:
+        """Return the histogram of the latencies of the rewraps of the method.
+
+        Each bucket with a count is a `(lower ns, upper ns, count)` tuple. The upper
+        bound of the highest bucket is the longest latency recorded.
+        """
+        ...
+
+    def reset_stats(self) -> None:
+        """Set the counters of the method back to zero."""
+        ...
@@ -0,0 +1,264 @@
+"""Fused method chains for NewType instances.
+
+Every method of a NewType that returns a base-type value normally rebuilds, and so
+re-validates, an instance of the NewType. In a chain such as
+`email.strip().lower().removesuffix(".")` only the last of those instances is kept.
+
+`FusedChain` runs such chains on plain base-type values instead, and builds the
+NewType instance once, when the value escapes the chain:
+    - explicitly, through `materialize()`
+    - implicitly, when it is compared, hashed, converted to `str`/`bool`/`int`/`float`,
+      used as an index, measured, iterated or formatted
+    - through an attribute that is not a method of the base type, or a method the
+      NewType redefines
+
+Arithmetic, bitwise and unary operators and indexing are steps of the chain, like the
+methods of the base type. A `FusedChain` is still not an instance of the base type:
+call `materialize()` before passing the value to code that checks its type, or that
+reads the base value directly, such as `str.join` or `json.dumps`.
+"""
+
+import operator
+from typing import TYPE_CHECKING, Any, Callable, Tuple
+
+
+if TYPE_CHECKING:
+    from typing import Dict
+
+
+__all__ = ["FusedChain"]
+
+# Class attribute of a NewType listing the methods of its base type it redefines
+NEWTYPE_OVERRIDES_STR = "_newtype_overrides_"
+
+
+def _operator_step(name: str, op: "Callable[..., Any]", reflected: bool = False) -> Any:
+    """Make a `FusedChain` method applying an operator as a step of the chain.
+
+    The base type's own special method is used, as for other methods, so that the
+    NewType does not rebuild the result; `op` only dispatches what it leaves to the
+    other operand.
+
+    Args:
+        name: The name of the special method
+        op: The function of the `operator` module it stands for
+        reflected: If true, the chain is the right operand
+
+    Returns
+    -------
+        The special method
+    """
+
+    def step(self: "FusedChain", *operands: Any) -> Any:
+        operands = tuple(o.materialize() if isinstance(o, FusedChain) else o for o in operands)
+        if name in getattr(self._cls, NEWTYPE_OVERRIDES_STR, ()):
+            value = self.materialize()
+            result = NotImplemented
+        else:
+            value = self._value
+            method = getattr(self._base, name, None)
+            result = NotImplemented if method is None else method(value, *operands)
+        if result is NotImplemented:
+            result = op(*operands, value) if reflected else op(value, *operands)
+        return self._chain(result)
+
+    step.__name__ = name
+    step.__doc__ = f"Apply `{name}` to the value as a step of the chain."
+    return step
+
+
+def _comparison(name: str, op: "Callable[[Any, Any], Any]") -> Any:
+    """Make a `FusedChain` method that materialises the chain and compares it.
+
+    Args:
+        name: The name of the special method
+        op: The function of the `operator` module it stands for
+
+    Returns
+    -------
+        The special method
+    """
+
+    def compare(self: "FusedChain", other: Any) -> Any:
+        return op(self.materialize(), other)
+
+    compare.__name__ = name
+    compare.__doc__ = f"Materialise and apply `{name}` to the NewType instance."
+    return compare
+
+
+def _conversion(name: str) -> Any:
+    """Make a `FusedChain` method that materialises the chain and converts it.
+
+    The base type's own method converts the instance, so that the result is a plain
+    value rather than a rebuilt NewType instance.
+
+    Args:
+        name: The name of the special method
+
+    Returns
+    -------
+        The special method
+    """
+
+    def convert(self: "FusedChain") -> Any:
+        method = getattr(self._base, name, None)
+        if method is None:
+            raise TypeError(f"`{self._base.__name__}` has no `{name}`")
+        return method(self.materialize())
+
+    convert.__name__ = name
+    convert.__doc__ = f"Materialise and convert the NewType instance with `{name}`."
+    return convert
+
+
+class FusedChain:
+    """A pending NewType value, carried through a method chain as its base value.
+
+    Create one with `instance.fused()`. Base-type methods and operators called on the
+    chain continue it; the chain is not an instance of the base type, so call
+    `materialize()` before passing it to code that checks for one.
+
+    Example:
+        ```python
+        email = EmailStr(raw).fused().strip().lower().removesuffix(".").materialize()
+        ```
+    """
+
+    __slots__ = ("_cls", "_base", "_value", "_init_args", "_init_kwargs")
+
+    def __init__(
+        self,
+        cls: type,
+        base: type,
+        value: Any,
+        init_args: "Tuple[Any, ...]" = (),
+        init_kwargs: "Dict[str, Any]" = {},  # noqa: B006
+    ) -> None:
+        """Initialize a chain.
+
+        Args:
+            cls: The NewType to materialise into
+            base: The base type whose methods run on `value`
+            value: The current value, an instance of `base` or of `cls`
+            init_args: Extra positional arguments passed to `cls` on materialisation
+            init_kwargs: Keyword arguments passed to `cls` on materialisation
+        """
+        self._cls = cls
+        self._base = base
+        self._value = value
+        self._init_args = init_args
+        self._init_kwargs = init_kwargs
+
+    def materialize(self) -> Any:
+        """Build the NewType instance, validating the value once.
+
+        Later calls return the same instance.
+
+        Returns
+        -------
+            An instance of the NewType, or the value itself if it already is one
+        """
+        value = self._value
+        if type(value) is not self._cls:
+            value = self._value = self._cls(value, *self._init_args, **self._init_kwargs)
+        return value
+
+    def __getattr__(self, name: str) -> Any:
+        """Resolve a base-type method as a step of the chain."""
+        attr = getattr(self._base, name, None)
+        if not callable(attr) or name in getattr(self._cls, NEWTYPE_OVERRIDES_STR, ()):
+            return getattr(self.materialize(), name)
+        return self._step(attr)
+
+    def _step(self, method: "Callable[..., Any]") -> "Callable[..., Any]":
+        def fused_method(*args: Any, **kwargs: Any) -> Any:
+            return self._chain(method(self._value, *args, **kwargs))
+
+        return fused_method
+
+    def _chain(self, result: Any) -> Any:
+        """Continue the chain with `result` if it is a base-type value."""
+        if isinstance(result, self._base):
+            return FusedChain(self._cls, self._base, result, self._init_args, self._init_kwargs)
+        return result
+
+    def __repr__(self) -> str:
+        """Materialise and return the `repr` of the NewType instance."""
+        return repr(self.materialize())
+
+    def __str__(self) -> str:
+        """Materialise and return the `str` of the NewType instance."""
+        return str(self.materialize())
+
+    def __format__(self, format_spec: str) -> str:
+        """Materialise and format the NewType instance."""
+        return format(self.materialize(), format_spec)
+
+    def __eq__(self, other: object) -> bool:
+        """Materialise and compare the NewType instance."""
+        return bool(self.materialize() == other)
+
+    def __ne__(self, other: object) -> bool:
+        """Materialise and compare the NewType instance."""
+        return bool(self.materialize() != other)
+
+    def __hash__(self) -> int:
+        """Materialise and hash the NewType instance."""
+        return hash(self.materialize())
+
+    def __bool__(self) -> bool:
+        """Materialise and return the truth value of the NewType instance."""
+        return bool(self.materialize())
+
+    def __len__(self) -> int:
+        """Materialise and return the length of the NewType instance."""
+        return len(self.materialize())
+
+    def __iter__(self) -> Any:
+        """Materialise and iterate over the NewType instance."""
+        return iter(self.materialize())
+
+    def __contains__(self, item: object) -> bool:
+        """Materialise and test membership in the NewType instance."""
+        return item in self.materialize()
+
+    __lt__ = _comparison("__lt__", operator.lt)
+    __le__ = _comparison("__le__", operator.le)
+    __gt__ = _comparison("__gt__", operator.gt)
+    __ge__ = _comparison("__ge__", operator.ge)
+    __int__ = _conversion("__int__")
+    __float__ = _conversion("__float__")
+    __index__ = _conversion("__index__")
+
+    __getitem__ = _operator_step("__getitem__", operator.getitem)
+    __neg__ = _operator_step("__neg__", operator.neg)
+    __pos__ = _operator_step("__pos__", operator.pos)
+    __abs__ = _operator_step("__abs__", operator.abs)
+    __invert__ = _operator_step("__invert__", operator.invert)
+    __add__ = _operator_step("__add__", operator.add)
+    __radd__ = _operator_step("__radd__", operator.add, reflected=True)
+    __sub__ = _operator_step("__sub__", operator.sub)
+    __rsub__ = _operator_step("__rsub__", operator.sub, reflected=True)
+    __mul__ = _operator_step("__mul__", operator.mul)
+    __rmul__ = _operator_step("__rmul__", operator.mul, reflected=True)
+    __matmul__ = _operator_step("__matmul__", operator.matmul)
+    __rmatmul__ = _operator_step("__rmatmul__", operator.matmul, reflected=True)
+    __truediv__ = _operator_step("__truediv__", operator.truediv)
+    __rtruediv__ = _operator_step("__rtruediv__", operator.truediv, reflected=True)
+    __floordiv__ = _operator_step("__floordiv__", operator.floordiv)
+    __rfloordiv__ = _operator_step("__rfloordiv__", operator.floordiv, reflected=True)
+    __mod__ = _operator_step("__mod__", operator.mod)
+    __rmod__ = _operator_step("__rmod__", operator.mod, reflected=True)
+    __pow__ = _operator_step("__pow__", operator.pow)
+    __rpow__ = _operator_step("__rpow__", operator.pow, reflected=True)
+    __lshift__ = _operator_step("__lshift__", operator.lshift)
+    __rlshift__ = _operator_step("__rlshift__", operator.lshift, reflected=True)
+    __rshift__ = _operator_step("__rshift__", operator.rshift)
+    __rrshift__ = _operator_step("__rrshift__", operator.rshift, reflected=True)
+    __and__ = _operator_step("__and__", operator.and_)
+    __rand__ = _operator_step("__rand__", operator.and_, reflected=True)
+    __xor__ = _operator_step("__xor__", operator.xor)
+    __rxor__ = _operator_step("__rxor__", operator.xor, reflected=True)
+    __or__ = _operator_step("__or__", operator.or_)
+    __ror__ = _operator_step("__ror__", operator.or_, reflected=True)
@@ -0,0 +1,92 @@
+"""Dictionaries keyed by NewType instances.
+
+Dictionaries and sets have fast paths for keys whose type is exactly `str`, which
+instances of a `NewType(str)` do not take, and a single such key moves a whole
+dictionary off them. `ExactKeyDict` accepts NewType instances as keys, but stores
+them unwrapped to their exact base type. Its lookups, iteration and hand-off to C
+libraries behave as for a dictionary built from plain values.
+"""
+
+from typing import Any, Iterable, Optional
+
+from .extensions.newtypeinit import unwrap
+
+
+__all__ = ["ExactKeyDict"]
+
+
+class ExactKeyDict(dict):  # type: ignore[type-arg]
+    """A `dict` that unwraps NewType keys to their exact base type on insertion.
+
+    Only inserting methods are overridden. Lookups need no unwrapping: a NewType
+    instance hashes and compares like its base value, so `d[user_id]` finds the
+    entry stored under the plain `str`. Keys come back as base-type values when
+    iterating.
+
+    Example:
+        ```python
+        counts = ExactKeyDict()
+        counts[UserId("alice")] = 1
+        assert type(next(iter(counts))) is str
+        assert counts[UserId("alice")] == counts["alice"] == 1
+        ```
+    """
+
+    __slots__ = ()
+
+    def __init__(self, *args: Any, **kwargs: Any) -> None:
+        """Initialize the dictionary like `dict`, unwrapping the keys."""
+        super().__init__()
+        self.update(*args, **kwargs)
+
+    def __setitem__(self, key: Any, value: Any) -> None:
+        """Set `self[unwrap(key)]` to `value`."""
+        super().__setitem__(unwrap(key), value)
+
+    def setdefault(self, key: Any, default: Any = None) -> Any:
+        """Insert `default` under `unwrap(key)` if absent, and return the value."""
+        return super().setdefault(unwrap(key), default)
+
+    def update(self, *args: Any, **kwargs: Any) -> None:
+        """Update the dictionary like `dict.update`, unwrapping the keys."""
+        if len(args) > 1:
+            raise TypeError(f"update expected at most 1 argument, got {len(args)}")
+        if args:
+            other = args[0]
+            items = other.items() if hasattr(other, "keys") else other
+            super().update((unwrap(k), v) for k, v in items)
+        if kwargs:
+            super().update(kwargs)
+
+    def __ior__(self, other: Any) -> "ExactKeyDict":
+        """Update the dictionary in place, unwrapping the keys."""
+        self.update(other)
+        return self
+
+    def __or__(self, other: Any) -> "ExactKeyDict":
+        """Return a new `ExactKeyDict` merging both dictionaries."""
+        if not isinstance(other, dict):
+            return NotImplemented
+        merged = self.copy()
+        merged.update(other)
+        return merged
+
+    def copy(self) -> "ExactKeyDict":
+        """Return a shallow copy, as an `ExactKeyDict`."""
+        return type(self)(self)
+
+    @classmethod
+    def fromkeys(cls, iterable: "Iterable[Any]", value: Optional[Any] = None) -> "ExactKeyDict":  # type: ignore[override]
+        """Create a dictionary with the unwrapped keys of `iterable`, all set to `value`."""
+        new = cls()
+        for key in iterable:
+            new[key] = value
+        return new
+
+    def __repr__(self) -> str:
+        """Return the representation of the dictionary."""
+        return f"{type(self).__name__}({super().__repr__()})"
+
+    def __reduce__(self) -> Any:
+        """Pickle the dictionary as its class and a plain `dict` of its items."""
+        return (type(self), (dict(self),))
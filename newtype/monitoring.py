@@ -0,0 +1,145 @@
+"""Attributing time to NewType machinery with `sys.monitoring` (PEP 669).
+
+Profilers that sample the C stack see the cost of NewType descriptors as time in an
+anonymous `tp_call`. `NewTypeProfiler` registers a `newtype` tool with
+`sys.monitoring`, on Python 3.12+. It times every call made from Python code to a
+NewType class or to one of its methods, and sorts it into one of three kinds:
+    - validation: constructing an instance, which runs the validation of the class
+    - rewrap: a method whose result was rewrapped into the NewType
+    - passthrough: a method whose result was returned as it was
+
+PEP 669 has no custom events, so the descriptors do not emit any. The profiler
+uses the `CALL`, `C_RETURN` and `C_RAISE` events that CPython emits around the
+calls, and tells rewraps from passthroughs with the counters of `enable_stats()`.
+Operators such as `a + b` make no `CALL` event, and are not timed. As for any
+`sys.monitoring` tool, nothing is monitored, and nothing costs anything, outside
+of `start()` and `stop()`.
+"""
+
+import sys
+import time
+from typing import TYPE_CHECKING, Any, Dict, List, Optional, Tuple
+
+from .extensions import newtypemethod
+from .extensions.newtypemethod import NewTypeMethod
+
+
+if TYPE_CHECKING:
+    from types import CodeType
+
+
+__all__ = ["NewTypeProfiler"]
+
+NEWTYPE_TOOL_NAME = "newtype"
+# the ids PEP 669 does not assign to debuggers, coverage, profilers and optimizers
+NEWTYPE_TOOL_IDS = (3, 4)
+
+
+class NewTypeProfiler:
+    """Times the calls to NewType classes and methods, by class and kind of call.
+
+    Times are inclusive: the time of a method that rewraps its result includes
+    the validation of the new instance.
+
+    Example:
+        ```python
+        with NewTypeProfiler() as profiler:
+            handle_request()
+        for cls, kinds in profiler.results().items():
+            print(cls.__name__, kinds)
+        # EmailStr {'validation': {'calls': 1, 'seconds': 2.1e-06},
+        #           'rewrap': {'calls': 2, 'seconds': 5.3e-06}}
+        ```
+    """
+
+    def __init__(self) -> None:
+        """Initialize a profiler that is not running yet."""
+        self.tool_id: Optional[int] = None
+        # calls, then nanoseconds, by class and kind
+        self.totals: Dict[type, Dict[str, List[int]]] = {}
+        # the calls in progress: callable, class, rewraps before the call, start
+        self._calls: List[Tuple[Any, type, int, int]] = []
+        self._stats_were_enabled = False
+
+    def start(self) -> "NewTypeProfiler":
+        """Register the `newtype` tool and start timing calls.
+
+        Raises
+        ------
+            RuntimeError: If `sys.monitoring` is not available, the profiler is
+                running already, or no tool id is free
+        """
+        if not hasattr(sys, "monitoring"):
+            raise RuntimeError("`NewTypeProfiler` needs `sys.monitoring`, from Python 3.12")
+        if self.tool_id is not None:
+            raise RuntimeError("the profiler is running already")
+        monitoring = sys.monitoring
+        for tool_id in NEWTYPE_TOOL_IDS:
+            if monitoring.get_tool(tool_id) is None:
+                break
+        else:
+            raise RuntimeError(f"no `sys.monitoring` tool id out of {NEWTYPE_TOOL_IDS} is free")
+        monitoring.use_tool_id(tool_id, NEWTYPE_TOOL_NAME)
+        self.tool_id = tool_id
+        # only the counters of the methods are read, to tell rewraps apart
+        self._stats_were_enabled = newtypemethod.set_stats_enabled(True)
+        events = monitoring.events
+        monitoring.register_callback(tool_id, events.CALL, self._on_call)
+        monitoring.register_callback(tool_id, events.C_RETURN, self._on_return)
+        monitoring.register_callback(tool_id, events.C_RAISE, self._on_return)
+        monitoring.set_events(tool_id, events.CALL | events.C_RETURN | events.C_RAISE)
+        return self
+
+    def stop(self) -> None:
+        """Stop timing calls and free the tool id; the results are kept."""
+        if self.tool_id is None:
+            return
+        monitoring = sys.monitoring
+        events = monitoring.events
+        monitoring.set_events(self.tool_id, 0)
+        for event in (events.CALL, events.C_RETURN, events.C_RAISE):
+            monitoring.register_callback(self.tool_id, event, None)
+        monitoring.free_tool_id(self.tool_id)
+        self.tool_id = None
+        newtypemethod.set_stats_enabled(self._stats_were_enabled)
+        self._calls.clear()
+
+    def __enter__(self) -> "NewTypeProfiler":
+        """Start the profiler."""
+        return self.start()
+
+    def __exit__(self, *_exc_info: Any) -> None:
+        """Stop the profiler."""
+        self.stop()
+
+    def results(self) -> "Dict[type, Dict[str, Dict[str, float]]]":
+        """Return the number of calls and the seconds spent, by class and kind.
+
+        The kinds are `validation`, `rewrap` and `passthrough`; only those that
+        were called are included.
+        """
+        return {
+            cls: {
+                kind: {"calls": calls, "seconds": ns / 1e9} for kind, (calls, ns) in kinds.items()
+            }
+            for cls, kinds in self.totals.items()
+        }
+
+    def _on_call(self, _code: "CodeType", _offset: int, func: Any, _arg0: Any) -> None:
+        if type(func) is NewTypeMethod:
+            self._calls.append((func, func.cls, func.rewraps, time.perf_counter_ns()))
+        elif isinstance(func, type) and hasattr(func, "__newtype_stats__"):
+            self._calls.append((func, func, -1, time.perf_counter_ns()))
+
+    def _on_return(self, _code: "CodeType", _offset: int, func: Any, _arg0: Any) -> None:
+        if not self._calls or self._calls[-1][0] is not func:
+            return
+        end = time.perf_counter_ns()
+        _, cls, rewraps, start = self._calls.pop()
+        if rewraps < 0:
+            kind = "validation"
+        else:
+            kind = "rewrap" if func.rewraps > rewraps else "passthrough"
+        totals = self.totals.setdefault(cls, {}).setdefault(kind, [0, 0])
+        totals[0] += 1
+        totals[1] += end - start
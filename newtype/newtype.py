@@ -7,6 +7,8 @@ preservation, and proper inheritance handling.
 The module consists of several key components:
     - NewType: The main factory function for creating new types
     - newtype_exclude: Decorator to exclude methods from type wrapping
+    - newtype_invariant: Decorator to skip re-validation when rewrapping results
+    - raw: Context manager suspending the rewrapping of method results
     - BaseNewType: The base class for all NewType instances
     - Type caching system for performance optimization
 
@@ -25,7 +27,10 @@ Technical Details:
 from typing import (
     TYPE_CHECKING,
     Any,
+    Iterable,
+    Optional,
     Sequence,
+    Tuple,
     TypeVar,
     Union,
     cast,
@@ -36,22 +41,39 @@ if TYPE_CHECKING:
     from typing import (
         Callable,
         Dict,
+        Iterator,
         List,
+        Set,
     )
 
 __all__: "List[str]" = []
 
 import logging
+import math
+import os
 import sys
+from collections import OrderedDict
+from contextlib import contextmanager
 from logging import getLogger
-from weakref import WeakKeyDictionary
+from weakref import WeakKeyDictionary, WeakValueDictionary
 
+from .extensions import newtypeinit, newtypemethod
 from .extensions.newtypeinit import (
+    NEWTYPE_FREELIST_STR,
     NEWTYPE_INIT_ARGS_STR,
     NEWTYPE_INIT_KWARGS_STR,
+    NEWTYPE_PENDING_STR,
+    NativeValidator,
     NewTypeInit,
+    construct_many,
+    freelist_stats,
+    instantiate,
+    set_freelist,
+    unsafe_cast,
+    validate_pending,
 )
-from .extensions.newtypemethod import NewTypeMethod
+from .extensions.newtypemethod import NewTypeMethod, raw_enter, raw_exit
+from .fused import NEWTYPE_OVERRIDES_STR, FusedChain
 
 
 NEWTYPE_LOGGER = getLogger("newtype-python")
@@ -62,7 +84,27 @@ logging.basicConfig(
     stream=sys.stdout,
 )
 
+NEWTYPE_ARGS_STR = "_newtype_args_"
 NEWTYPE_EXCLUDE_FUNC_STR = "_newtype_exclude_func_"
+NEWTYPE_INVARIANT_FUNC_STR = "_newtype_invariant_func_"
+NEWTYPE_INVARIANTS_STR = "__newtype_invariants__"
+NEWTYPE_INTERN_STR = "_newtype_intern_"
+NEWTYPE_INIT_READS_VALUE_STR = "_newtype_init_reads_value_"
+# instances kept by the pool of an interned class whose instances cannot be referenced
+# weakly, unless `intern` gives another bound
+NEWTYPE_INTERN_MAX = 4096
+# types whose equal values are identical, so that their values key intern pools as they
+# are
+NEWTYPE_INTERN_OWN_KEYS = (str, bytes, int, bool)
+NEWTYPE_PARAMS_STR = "_newtype_params_"
+NEWTYPE_POOL_STR = "_newtype_pool_"
+NEWTYPE_VALIDATOR_STR = "_newtype_validator_"
+NEWTYPE_VALIDATION_STR = "_newtype_validation_"
+NEWTYPE_VALIDATION_MODES = ("eager", "lazy")
+# methods that `object` defines, so that they are inherited rather than wrapped, and
+# through which a pending value could pass for a valid one
+NEWTYPE_LAZY_GUARDED_STRS = ("__eq__", "__ne__", "__lt__", "__le__", "__gt__", "__ge__", "__hash__")
+LATENCY_PERCENTILES = (("p50", 0.5), ("p90", 0.9), ("p99", 0.99), ("p999", 0.999))
 UNDEFINED = object()
 
 
@@ -70,6 +112,10 @@ T = TypeVar("T", bound=type)
 
 
 __GLOBAL_INTERNAL_TYPE_CACHE__: "WeakKeyDictionary[type, type]" = WeakKeyDictionary()
+# parameterised NewTypes of each base type, by parameter names
+__GLOBAL_INTERNAL_PARAMS_CACHE__: "WeakKeyDictionary[type, Dict[Tuple[str, ...], type]]" = (
+    WeakKeyDictionary()
+)
 
 
 def newtype_exclude(func: "Callable[..., Any]") -> "Callable[..., Any]":
@@ -111,6 +157,488 @@ def func_is_excluded(func: "Callable[..., Any]") -> bool:
     return getattr(func, NEWTYPE_EXCLUDE_FUNC_STR, False)
 
 
+def intern_key(value: Any) -> Any:
+    """Return the key under which an intern pool keeps the instance of `value`.
+
+    Equal values share a key only if they are identical: of the same types down to
+    their elements, and with the same sign for floats, so that `-0.0` and `0.0`, or
+    `(1.0, 2)` and `(1, 2)`, get instances of their own.
+
+    Args:
+        value: A hashable value
+
+    Returns
+    -------
+        A tuple of the type of `value` and what tells it from equal values of other
+        types and signs
+    """
+    cls = type(value)
+    if cls in NEWTYPE_INTERN_OWN_KEYS:
+        return (cls, value)
+    if cls is float:
+        return (cls, value, math.copysign(1.0, value))
+    if cls is complex:
+        return (cls, value, math.copysign(1.0, value.real), math.copysign(1.0, value.imag))
+    if cls is tuple:
+        return (cls, tuple(map(intern_key, value)))
+    if cls is frozenset:
+        return (cls, frozenset(map(intern_key, value)))
+    # `repr` tells apart equal values of other types, such as `Decimal("1.0")` and
+    # `Decimal("1")`
+    return (cls, value, repr(value))
+
+
+class InternKeys:
+    """Pool instances of an interned NewType under `intern_key` of their value."""
+
+    __slots__ = ()
+
+    def __contains__(self, key: Any) -> bool:
+        """Return whether an instance of the value `key` is pooled."""
+        return super().__contains__(intern_key(key))  # type: ignore[misc]
+
+    def __getitem__(self, key: Any) -> Any:
+        """Return the pooled instance of the value `key`."""
+        return super().__getitem__(intern_key(key))  # type: ignore[misc]
+
+    def __setitem__(self, key: Any, value: Any) -> None:
+        """Pool `value` as the instance of the value `key`."""
+        super().__setitem__(intern_key(key), value)  # type: ignore[misc]
+
+    def get(self, key: Any, default: Any = None) -> Any:
+        """Return the pooled instance of the value `key`, or `default`."""
+        return super().get(intern_key(key), default)  # type: ignore[misc]
+
+
+class InternPool(OrderedDict):  # type: ignore[type-arg]
+    """The pool of an interned NewType whose instances cannot be referenced weakly.
+
+    It holds at most `maxsize` instances. Once it is full, pooling a new instance
+    evicts the one pooled first. An evicted instance stays valid, but the next
+    construction of its value pools a new one in its place.
+    """
+
+    __slots__ = ("maxsize",)
+
+    def __init__(self, maxsize: int) -> None:
+        """Initialize an empty pool of at most `maxsize` instances."""
+        super().__init__()
+        self.maxsize = maxsize
+
+    def __setitem__(self, key: Any, value: Any) -> None:
+        """Pool `value` under `key`, evicting the oldest instance if the pool is full."""
+        super().__setitem__(key, value)
+        if len(self) > self.maxsize:
+            self.popitem(last=False)
+
+
+class KeyedInternPool(InternKeys, InternPool):  # type: ignore[misc]
+    """An `InternPool` for a base type whose equal values can differ."""
+
+    __slots__ = ()
+
+
+class KeyedWeakPool(InternKeys, WeakValueDictionary):  # type: ignore[type-arg]
+    """A weak intern pool for a base type whose equal values can differ."""
+
+
+def resolve_intern(
+    cls: type, base_type: type, intern: "Optional[Union[bool, int]]"
+) -> "Optional[Any]":
+    """Resolve the interning mode of a NewType subclass and create its pool.
+
+    Args:
+        cls: The subclass being initialized
+        base_type: The type wrapped by `cls`
+        intern: The mode given as a class keyword, or None to inherit it; an int
+            bounds the pool of a class whose instances cannot be referenced weakly
+
+    Returns
+    -------
+        The pool of canonical instances of `cls`, or None if it is not interned
+    """
+    if intern is None:
+        intern = getattr(cls, NEWTYPE_INTERN_STR, False)
+    if not isinstance(intern, bool) and (not isinstance(intern, int) or intern < 1):
+        raise ValueError(f"`intern` must be a bool or a positive int, got {intern!r}")
+    setattr(cls, NEWTYPE_INTERN_STR, intern)
+    pool = None
+    if intern:
+        if base_type.__hash__ is None:
+            raise TypeError(f"cannot intern `{cls.__name__}`: `{base_type.__name__}` is unhashable")
+        keyed = base_type not in NEWTYPE_INTERN_OWN_KEYS
+        maxsize = NEWTYPE_INTERN_MAX if intern is True else intern
+        if cls.__weakrefoffset__:
+            pool = KeyedWeakPool() if keyed else WeakValueDictionary()
+        else:
+            pool = KeyedInternPool(maxsize) if keyed else InternPool(maxsize)
+    setattr(cls, NEWTYPE_POOL_STR, pool)
+    return pool
+
+
+def resolve_freelist(cls: type, freelist: "Optional[int]") -> None:
+    """Create the free-list of a NewType subclass, if it was given one.
+
+    Free-lists are not inherited: a subclass of a class with one allocates its
+    instances as usual unless given a capacity of its own.
+
+    Args:
+        cls: The subclass being initialized
+        freelist: The capacity given as a class keyword, or None for no free-list
+    """
+    if freelist:
+        set_freelist(cls, freelist)
+
+
+def resolve_init_reads_value(
+    cls: type, root: type, validator: "Optional[NativeValidator]", lazy: bool, pool: Any
+) -> None:
+    """Record whether constructing a NewType subclass looks at its value.
+
+    It does not if no class up to `root` defines the `__init__` that `cls` runs, or
+    if the class that does declares `_newtype_init_reads_value_ = False`, and the
+    value is neither validated natively, nor kept for lazy validation, nor pooled. A
+    method whose container result nothing else refers to then moves its contents
+    into the instance it rewraps rather than copying them.
+
+    Args:
+        cls: The subclass being initialized, before its `__init__` is wrapped
+        root: The `BaseNewType` whose `__init__` ignores the value
+        validator: The native validator of `cls`, if any
+        lazy: Whether `cls` validates lazily
+        pool: The intern pool of `cls`, if any
+    """
+    reads = validator is not None or lazy or pool is not None
+    if not reads:
+        owner = next(klass for klass in cls.__mro__ if "__init__" in vars(klass))
+        if owner is not root:
+            reads = vars(owner).get(NEWTYPE_INIT_READS_VALUE_STR, True)
+    setattr(cls, NEWTYPE_INIT_READS_VALUE_STR, reads)
+
+
+@contextmanager
+def raw() -> "Iterator[None]":
+    """Context manager in which methods of NewTypes return unwrapped results.
+
+    Chained transformations then work on plain base-type values, without building
+    and validating an intermediate instance at every step; wrap the final value
+    back with `T.rewrap`. The scope is tracked by a context variable, so it covers
+    the current thread or task only.
+
+    Example:
+        ```python
+        with newtype.raw():
+            cleaned = email.strip().lower().replace(" ", "")  # a plain `str`
+        email = EmailStr.rewrap(cleaned)
+        ```
+    """
+    token = raw_enter()
+    try:
+        yield
+    finally:
+        raw_exit(token)
+
+
+def enable_stats(enabled: bool = True, latency: bool = False) -> bool:
+    """Make the NewType descriptors keep runtime counters, or stop them.
+
+    The counters are compiled in, but only kept while statistics are enabled, so
+    that the cost when they are not is one branch per call. Read them with
+    `newtype.stats()` or `T.__newtype_stats__()`.
+
+    Args:
+        enabled: Whether to keep the counters
+        latency: Whether to also record the latency of every rewrap and
+            validation, read with `newtype.latency()`; this costs two clock
+            reads each
+
+    Returns
+    -------
+        bool: Whether the counters were kept before the call
+    """
+    previous = newtypemethod.set_stats_enabled(enabled)
+    newtypeinit.set_stats_enabled(enabled)
+    newtypemethod.set_latency_enabled(enabled and latency)
+    newtypeinit.set_latency_enabled(enabled and latency)
+    return previous
+
+
+def newtype_classes() -> "Iterator[type]":
+    """Yield every NewType class alive, the `BaseNewType`s included."""
+    seen: "Set[type]" = set()  # noqa: UP037
+    pending = list(__GLOBAL_INTERNAL_TYPE_CACHE__.values())
+    while pending:
+        cls = pending.pop()
+        if cls in seen:
+            continue
+        seen.add(cls)
+        yield cls
+        pending.extend(cls.__subclasses__())
+
+
+def newtype_descriptors(cls: type, own: bool = False) -> "Dict[str, Any]":
+    """Return the `NewTypeInit` and `NewTypeMethod` descriptors of a class, by name.
+
+    Args:
+        cls: The class
+        own: Only those set on `cls` itself, not those it inherits
+    """
+    descriptors: "Dict[str, Any]" = {}  # noqa: UP037
+    for klass in (cls,) if own else cls.__mro__:
+        for name, v in vars(klass).items():
+            if name not in descriptors and isinstance(v, (NewTypeInit, NewTypeMethod)):
+                descriptors[name] = v
+    return descriptors
+
+
+def newtype_stats(cls: type) -> "Dict[str, Dict[str, int]]":
+    """Return the counters of the descriptors of a NewType that were used, by name.
+
+    The counters of `__init__` are those of the constructor. Instantiations of a
+    parameterised NewType share the descriptors, and so the counters, of the
+    generic class.
+    """
+    counters = {name: d.stats() for name, d in newtype_descriptors(cls).items()}
+    return {name: c for name, c in counters.items() if any(c.values())}
+
+
+def stats() -> "Dict[type, Dict[str, Dict[str, int]]]":
+    """Return the counters of every NewType whose descriptors were used.
+
+    Returns
+    -------
+        For each such class, the counters of each of its methods that were used, as
+        returned by `T.__newtype_stats__()`
+    """
+    result = {}
+    for cls in newtype_classes():
+        if newtype_descriptors(cls, own=True):
+            counters = newtype_stats(cls)
+            if counters:
+                result[cls] = counters
+    return result
+
+
+def latency_percentiles(buckets: "List[Tuple[int, int, int]]") -> "Dict[str, int]":
+    """Summarise latency histogram buckets as a count and percentiles, in ns.
+
+    Each percentile is the upper bound of the bucket it falls in, not a latency that
+    was recorded: it is at or above the true percentile, by at most a quarter of it.
+    `max` is exact, since the highest bucket of each
+    histogram reports the longest latency recorded as its upper bound.
+
+    Args:
+        buckets: `(lower ns, upper ns, count)` tuples, in any order; buckets of
+            several histograms with the same lower bound are merged
+    """
+    counts: "Dict[int, int]" = {}  # noqa: UP037
+    uppers: "Dict[int, int]" = {}  # noqa: UP037
+    for lower, upper, count in buckets:
+        if count:
+            counts[lower] = counts.get(lower, 0) + count
+            uppers[lower] = max(uppers.get(lower, upper), upper)
+    total = sum(counts.values())
+    summary = {"count": total}
+    for name, fraction in LATENCY_PERCENTILES:
+        rank, seen = math.ceil(fraction * total), 0
+        for lower, count in sorted(counts.items()):
+            seen += count
+            if seen >= rank:
+                summary[name] = uppers[lower]
+                break
+    summary["max"] = max(uppers.values(), default=0)
+    return summary
+
+
+def newtype_latency(cls: type) -> "Dict[str, Dict[str, int]]":
+    """Return the latency percentiles of a NewType, over all its methods.
+
+    `rewrap` is the time taken to build the instances that methods return, the
+    validation included; `validation` is the time taken by the validator and
+    `__init__` of the constructor. Only what was recorded is included.
+    """
+    buckets: "Dict[str, List[Tuple[int, int, int]]]" = {  # noqa: UP037
+        "rewrap": [],
+        "validation": [],
+    }
+    for descriptor in newtype_descriptors(cls).values():
+        kind = "validation" if isinstance(descriptor, NewTypeInit) else "rewrap"
+        buckets[kind] += descriptor.latency()
+    return {kind: latency_percentiles(b) for kind, b in buckets.items() if b}
+
+
+def latency() -> "Dict[type, Dict[str, Dict[str, int]]]":
+    """Return the latency percentiles of every NewType that recorded some.
+
+    Latencies are recorded while statistics are enabled with `latency=True`.
+
+    Returns
+    -------
+        For each such class, the percentiles of its rewraps and validations, as
+        returned by `T.__newtype_latency__()`
+    """
+    result = {}
+    for cls in newtype_classes():
+        if newtype_descriptors(cls, own=True):
+            percentiles = newtype_latency(cls)
+            if percentiles:
+                result[cls] = percentiles
+    return result
+
+
+def reset_stats(cls: "Optional[type]" = None) -> None:
+    """Set the counters of a NewType, or of every NewType, back to zero.
+
+    The latencies recorded are dropped too.
+
+    Args:
+        cls: The NewType whose counters to reset; all of them if None
+    """
+    for klass in newtype_classes() if cls is None else (cls,):
+        for descriptor in newtype_descriptors(klass).values():
+            descriptor.reset_stats()
+
+
+def enable_trace(enabled: bool = True) -> bool:
+    """Make the NewType descriptors record trace events, or stop them.
+
+    Each thread records into a ring buffer of its own, which keeps its latest
+    4096 events. A record only holds the event, the address of the NewType and a
+    timestamp; `trace_dump()` formats them. The records are kept after tracing
+    stops, until `trace_dump(clear=True)`.
+
+    Args:
+        enabled: Whether to record trace events
+
+    Returns
+    -------
+        bool: Whether they were recorded before the call
+    """
+    previous = newtypemethod.set_trace_enabled(enabled)
+    newtypeinit.set_trace_enabled(enabled)
+    return previous
+
+
+def trace_dump(clear: bool = False) -> "List[str]":
+    """Format the trace events recorded since `enable_trace()`, oldest first.
+
+    Each line gives the time in microseconds since the first event, the thread,
+    the event and the NewType. A NewType that no longer exists shows as its
+    address.
+
+    Args:
+        clear: Drop the records, and free the buffers of exited threads, once
+            formatted
+
+    Returns
+    -------
+        One line per event
+    """
+    records = newtypemethod.trace_records() + newtypeinit.trace_records()
+    if clear:
+        newtypemethod.trace_clear()
+        newtypeinit.trace_clear()
+    records.sort(key=lambda record: record[1])
+    names = {id(cls): f"{cls.__module__}.{cls.__qualname__}" for cls in newtype_classes()}
+    start = records[0][1] if records else 0
+    return [
+        f"{(ns - start) / 1000:12.3f}us thread {thread:x} {event:<14}"
+        f"{names.get(address, f'<type at {address:#x}>')}"
+        for thread, ns, event, address in records
+    ]
+
+
+def resolve_validation(cls: type, validation: "Optional[str]") -> bool:
+    """Resolve and record the validation mode of a NewType subclass.
+
+    Args:
+        cls: The subclass being initialized
+        validation: The mode given as a class keyword, or None to inherit it
+
+    Returns
+    -------
+        bool: True if `cls` validates lazily, False otherwise
+    """
+    if validation is None:
+        validation = getattr(cls, NEWTYPE_VALIDATION_STR, "eager")
+    if validation not in NEWTYPE_VALIDATION_MODES:
+        raise ValueError(
+            f"`validation` must be one of {NEWTYPE_VALIDATION_MODES}, got {validation!r}"
+        )
+    lazy = validation == "lazy"
+    if lazy and not cls.__dictoffset__ and not hasattr(cls, NEWTYPE_PENDING_STR):
+        raise TypeError(
+            f"`{cls.__name__}` has no `__dict__` to keep the pending record in; "
+            f"add {NEWTYPE_PENDING_STR!r} to its `__slots__`"
+        )
+    setattr(cls, NEWTYPE_VALIDATION_STR, validation)
+    return lazy
+
+
+def guard_pending(cls: type, base_type: type, cls_dict: "Dict[str, Any]") -> None:
+    """Make the comparisons and hash of a lazy NewType subclass validate first.
+
+    The base type's versions of the methods in `NEWTYPE_LAZY_GUARDED_STRS` are set
+    on `cls`, wrapped so that they validate a pending instance and return their
+    results as they are; those that `cls` defines itself are left to it.
+
+    Args:
+        cls: The subclass being initialized
+        base_type: The type wrapped by `cls`
+        cls_dict: The attributes `cls` was defined with
+    """
+    for k in NEWTYPE_LAZY_GUARDED_STRS:
+        v = getattr(base_type, k)
+        if k not in cls_dict and v is not None and v is not getattr(object, k):
+            setattr(cls, k, NewTypeMethod(v, base_type, lazy=True, rewrap=False))
+
+
+def newtype_invariant(func: "Callable[..., Any]") -> "Callable[..., Any]":
+    """Decorator to mark a method as preserving the invariant of its NewType.
+
+    The results of such methods are rewrapped into the subtype directly, without
+    running `__init__` again, since they are valid by construction. Methods of the
+    base type that are not overridden can be marked by listing their names in the
+    `__newtype_invariants__` class attribute instead.
+
+    Args:
+        func: The function to be marked
+
+    Returns
+    -------
+        The original function, marked with an invariant flag
+
+    Example:
+        ```python
+        class EmailStr(NewType(str)):
+            __newtype_invariants__ = ("strip",)
+
+            def __init__(self, val: str) -> None:
+                if "@" not in val:
+                    raise ValueError("Not an email")
+
+            @newtype_invariant
+            def lower(self) -> str:
+                return super().lower()
+        ```
+    """
+    setattr(func, NEWTYPE_INVARIANT_FUNC_STR, True)
+    return func
+
+
+def func_is_invariant(func: "Callable[..., Any]") -> bool:
+    """Check if a function is marked as invariant-preserving.
+
+    Args:
+        func: The function to check
+
+    Returns
+    -------
+        bool: True if the function is marked, False otherwise
+    """
+    return getattr(func, NEWTYPE_INVARIANT_FUNC_STR, False)
+
+
 def can_subclass_have___slots__(base_type: T) -> bool:
     try:
 
@@ -122,7 +650,45 @@ def can_subclass_have___slots__(base_type: T) -> bool:
     return True
 
 
-def NewType(base_type: T, **_context: "Dict[str, Any]") -> "T":  # noqa: N802, C901
+def parameterised_newtype(base: type, params: "Tuple[str, ...]") -> type:
+    """Create the generic NewType over `base` taking the class parameters `params`.
+
+    Subscripting it, or a subclass of it, with one argument per parameter returns
+    an instantiation: a subclass whose only attributes are the parameters set to
+    the arguments. Instantiations are created once per arguments, by the C
+    function `instantiate`, and skip the method wrapping of `__init_subclass__`,
+    so they share the method descriptors of the generic class.
+
+    Args:
+        base: The `BaseNewType` of the base type
+        params: The names of the class attributes set by instantiations
+
+    Returns
+    -------
+        The generic class
+    """
+    if not params or not all(isinstance(p, str) and p.isidentifier() for p in params):
+        raise ValueError(f"`params` must be a non-empty sequence of identifiers, got {params!r}")
+    if len(set(params)) != len(params):
+        raise ValueError(f"`params` must not repeat names, got {params!r}")
+    cache = __GLOBAL_INTERNAL_PARAMS_CACHE__.setdefault(base, {})
+    if params not in cache:
+        cache[params] = type(base)(
+            "ParameterisedNewType",
+            (base,),
+            {
+                "__slots__": (),
+                "__module__": base.__module__,
+                NEWTYPE_PARAMS_STR: params,
+                "__class_getitem__": classmethod(instantiate),
+            },
+        )
+    return cache[params]
+
+
+def NewType(  # noqa: N802, C901
+    base_type: T, params: "Optional[Sequence[str]]" = None, **_context: "Dict[str, Any]"
+) -> "T":
     """Create a new type that preserves type information through all operations.
 
     This is the main factory function for creating new types. It wraps an existing
@@ -131,6 +697,8 @@ def NewType(base_type: T, **_context: "Dict[str, Any]") -> "T":  # noqa: N802, C
 
     Args:
         base_type: The base type to wrap
+        params: Names of class attributes that subscripting the new type sets, as in
+            `Bounded[10]`; see `parameterised_newtype`
         **context: Additional context for type creation (reserved for future use)
 
     Returns
@@ -160,6 +728,11 @@ def NewType(base_type: T, **_context: "Dict[str, Any]") -> "T":  # noqa: N802, C
     if not isinstance(base_type, type):
         raise TypeError(f"Expected a type, got {type(base_type).__name__}")
 
+    if params is not None:
+        if isinstance(params, str):
+            params = (params,)
+        return cast(T, parameterised_newtype(NewType(base_type), tuple(params)))
+
     try:
         # we try to see if it is cached, if it is not, no problem either
         if base_type in __GLOBAL_INTERNAL_TYPE_CACHE__:
@@ -191,7 +764,19 @@ def NewType(base_type: T, **_context: "Dict[str, Any]") -> "T":  # noqa: N802, C
                     NEWTYPE_INIT_KWARGS_STR,
                 )
 
-        def __init_subclass__(cls, **init_subclass_context: Any) -> None:
+        # used by `unsafe_cast` to build instances like `__new__` does
+        _newtype_base_ = base_type
+        # canonical instances of an interned subclass, by base value
+        _newtype_pool_: "Optional[Any]" = None
+
+        def __init_subclass__(
+            cls,
+            validator: "Optional[NativeValidator]" = None,
+            validation: "Optional[str]" = None,
+            intern: "Optional[Union[bool, int]]" = None,
+            freelist: "Optional[int]" = None,
+            **init_subclass_context: Any,
+        ) -> None:
             """Initialize a subclass of BaseNewType.
 
             This method is called when creating a new subclass of BaseNewType.
@@ -202,20 +787,63 @@ def NewType(base_type: T, **_context: "Dict[str, Any]") -> "T":  # noqa: N802, C
             - Constructor initialization
 
             Args:
+                validator: A `NativeValidator` run on the value before `__init__`;
+                    inherited by subclasses when not given
+                validation: `"eager"` (the default) validates on construction,
+                    `"lazy"` on first use of a wrapped method, comparison or hash,
+                    or on `validate()`; inherited by subclasses when not given
+                intern: If true, constructing from a value of the base type returns
+                    one canonical instance per value; inherited by subclasses when
+                    not given, each subclass getting its own pool. Pools of classes
+                    without weak references keep at most `NEWTYPE_INTERN_MAX`
+                    instances, or as many as an int given here
+                freelist: Keep up to this many deallocated instances for reuse by
+                    the next ones, for fixed-size base types such as `float`; not
+                    inherited by subclasses
                 **context: Additional context for subclass initialization
             """
             super().__init_subclass__(**init_subclass_context)
 
+            if (
+                NEWTYPE_ARGS_STR in cls.__dict__
+                and validator is validation is intern is freelist is None
+                and not getattr(cls, NEWTYPE_INTERN_STR, False)
+            ):
+                # an instantiation of a parameterised NewType inherits everything
+                # from the generic class, except for the pool of an interned one
+                return
+
+            if validator is None:
+                validator = getattr(cls, NEWTYPE_VALIDATOR_STR, None)
+            setattr(cls, NEWTYPE_VALIDATOR_STR, validator)
+
+            lazy = resolve_validation(cls, validation)
+            pool = resolve_intern(cls, base_type, intern)
+            resolve_freelist(cls, freelist)
+            resolve_init_reads_value(cls, BaseNewType, validator, lazy, pool)
+            invariants = {
+                name
+                for klass in cls.__mro__
+                for name in vars(klass).get(NEWTYPE_INVARIANTS_STR, ())
+            }
+
             constructor = cls.__init__
             original_cls_dict: "Dict[str, Any]" = {}  # noqa: UP037
             original_cls_dict.update(cls.__dict__)
             for k, v in base_type.__dict__.items():
                 if callable(v) and (k not in object.__dict__) and (k not in original_cls_dict):
-                    setattr(cls, k, NewTypeMethod(v, base_type))
+                    setattr(
+                        cls,
+                        k,
+                        NewTypeMethod(v, base_type, lazy=lazy, invariant=k in invariants),
+                    )
                 elif k not in object.__dict__:
-                    if k == "__dict__":
+                    # a free-list belongs to the class it was made for
+                    if k in ("__dict__", NEWTYPE_FREELIST_STR):
                         continue
                     setattr(cls, k, v)
+            if lazy:
+                guard_pending(cls, base_type, original_cls_dict)
             for k, v in original_cls_dict.items():
                 if (
                     callable(v)
@@ -223,7 +851,12 @@ def NewType(base_type: T, **_context: "Dict[str, Any]") -> "T":  # noqa: N802, C
                     and k in base_type.__dict__
                     and not func_is_excluded(v)
                 ):
-                    setattr(cls, k, NewTypeMethod(v, base_type))
+                    invariant = k in invariants or func_is_invariant(v)
+                    setattr(
+                        cls,
+                        k,
+                        NewTypeMethod(v, base_type, lazy=lazy, invariant=invariant),
+                    )
 
                 else:
                     if k == "__dict__":
@@ -232,7 +865,20 @@ def NewType(base_type: T, **_context: "Dict[str, Any]") -> "T":  # noqa: N802, C
                         setattr(cls, k, v)
                     except AttributeError:
                         continue
-            cls.__init__ = NewTypeInit(constructor)  # type: ignore[method-assign]
+            # methods of the base type that `cls` redefines; fused chains leave
+            # them to the materialised instance
+            setattr(
+                cls,
+                NEWTYPE_OVERRIDES_STR,
+                frozenset(
+                    k
+                    for k, v in original_cls_dict.items()
+                    if callable(v) and k in base_type.__dict__
+                ),
+            )
+            cls.__init__ = NewTypeInit(  # type: ignore[method-assign]
+                constructor, validator, lazy=lazy, pool=pool
+            )
 
         def __new__(cls, value: Any = None, *_args: Any, **_kwargs: Any) -> "BaseNewType":
             """Create a new instance of BaseNewType.
@@ -245,6 +891,11 @@ def NewType(base_type: T, **_context: "Dict[str, Any]") -> "T":  # noqa: N802, C
                 *_args: Additional positional arguments
                 **_kwargs: Additional keyword arguments
             """
+            pool = cls._newtype_pool_
+            if pool is not None and type(value) is base_type and not _args and not _kwargs:
+                inst = pool.get(value)
+                if inst is not None:
+                    return cast("BaseNewType", inst)
             if base_type.__new__ == object.__new__:
                 inst = object.__new__(cls)
 
@@ -280,6 +931,93 @@ def NewType(base_type: T, **_context: "Dict[str, Any]") -> "T":  # noqa: N802, C
             # avoid python from calling `object.__init__`
             ...
 
+        def validate(self) -> "BaseNewType":
+            """Run the validation deferred by `validation="lazy"`.
+
+            Does nothing if the instance is already validated, or if its class
+            validates eagerly. On failure the instance stays unvalidated, so every
+            later use raises the same error.
+
+            Returns
+            -------
+                The instance itself, so that calls can be chained
+            """
+            validate_pending(self)
+            return self
+
+        # called by `NewTypeMethod` even if a subclass overrides `validate`
+        _newtype_validate_ = validate
+
+        # `T.unsafe_cast(value)` wraps trusted values without validating them; bound
+        # straight to the C function so that no Python frame is involved
+        unsafe_cast = classmethod(unsafe_cast)
+
+        # `T.freelist_stats()` reports how well the free-list of `T` is reused
+        freelist_stats = classmethod(freelist_stats)
+
+        # `T.__newtype_stats__()` returns the counters kept by `enable_stats()`,
+        # and `T.__newtype_latency__()` the percentiles of its latencies
+        __newtype_stats__ = classmethod(newtype_stats)
+        __newtype_latency__ = classmethod(newtype_latency)
+
+        def fused(self) -> "FusedChain":
+            """Start a fused method chain on the instance.
+
+            Methods of the base type called on the chain return plain base-type
+            values, and the instance is only rebuilt and validated when the value
+            leaves the chain; see `newtype.fused`.
+
+            Returns
+            -------
+                A `FusedChain` over the value of the instance
+            """
+            self._newtype_validate_()
+            return FusedChain(
+                type(self),
+                base_type,
+                self,
+                getattr(self, NEWTYPE_INIT_ARGS_STR, ()),
+                getattr(self, NEWTYPE_INIT_KWARGS_STR, {}),
+            )
+
+        @classmethod
+        def rewrap(cls, value: Any) -> "BaseNewType":
+            """Wrap a value back into the class, typically on leaving `raw()`.
+
+            Args:
+                value: A base-type value, or an instance of the class
+
+            Returns
+            -------
+                `value` itself if it already has the exact type, `cls(value)` otherwise
+            """
+            if type(value) is cls:
+                return cast("BaseNewType", value)
+            return cast("BaseNewType", cls(value))
+
+        @classmethod
+        def batch(
+            cls, values: "Iterable[Any]", workers: "Optional[int]" = None
+        ) -> "List[BaseNewType]":
+            """Construct an instance for every value, preserving order.
+
+            If the class has a `NativeValidator`, every value is validated before any
+            instance is built, split across `workers` threads (default: one per CPU)
+            with the GIL released. The first invalid value by position is reported,
+            regardless of how the work was scheduled.
+
+            Args:
+                values: The values to construct instances from
+                workers: The maximum number of threads to validate with
+
+            Returns
+            -------
+                A list of instances, in the same order as `values`
+            """
+            if workers is None:
+                workers = os.cpu_count() or 1
+            return cast("List[BaseNewType]", construct_many(cls, values, workers))
+
     try:
         # we try to store it in a cache, if it fails, no problem either
         if base_type not in __GLOBAL_INTERNAL_TYPE_CACHE__:
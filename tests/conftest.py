@@ -53,3 +53,50 @@ def limit_leaks(memstring: str):
             return func
 
     return decorator
+
+
+ALLOCATION_ROUNDS: int = 1000
+
+
+def pytest_configure(config: Any) -> None:
+    config.addinivalue_line(
+        "markers",
+        "allocations(extra=None, at_most=None): the allocations an operation may make "
+        "on top of its baseline, exactly or at most; checked by the `allocations` fixture",
+    )
+
+
+@pytest.fixture
+def allocations(request: Any) -> Callable:
+    """Check an operation against the budget of the test's `allocations` marker.
+
+    The operation and its baseline, the same operation on plain values, are called
+    `ALLOCATION_ROUNDS` times each, with the allocators counting. The difference in
+    allocations per call must match the budget, and every block the operation
+    allocates must be freed again.
+    """
+    from newtype.extensions import count_allocations
+
+    marker = request.node.get_closest_marker("allocations")
+    if marker is None:
+        pytest.fail("the `allocations` fixture needs an `allocations` marker")
+    extra = marker.kwargs.get("extra", marker.args[0] if marker.args else None)
+    at_most = marker.kwargs.get("at_most")
+
+    def per_call(operation: Callable[[], Any]) -> "tuple[float, float]":
+        operation()  # fill caches and free-lists first
+        allocated, freed = count_allocations(operation, ALLOCATION_ROUNDS)
+        return allocated / ALLOCATION_ROUNDS, (allocated - freed) / ALLOCATION_ROUNDS
+
+    def check(operation: Callable[[], Any], baseline: Callable[[], Any] = lambda: None) -> int:
+        allocated, kept = per_call(operation)
+        baseline_allocated, _ = per_call(baseline)
+        measured = round(allocated - baseline_allocated)
+        assert kept < 0.5, f"{kept:.2f} blocks per call are never freed"
+        if extra is not None:
+            assert measured == extra, f"{measured} extra allocations per call, expected {extra}"
+        if at_most is not None:
+            assert measured <= at_most, f"{measured} extra allocations per call, at most {at_most}"
+        return measured
+
+    return check
@@ -0,0 +1,95 @@
+import enum
+
+import pytest
+
+from newtype import NewType
+from newtype.extensions import count_allocations
+
+
+class Text(NewType(str)):
+    pass
+
+
+class Number(NewType(int)):
+    pass
+
+
+class Real(NewType(float)):
+    pass
+
+
+class Level(Number, enum.Enum):
+    LOW = 1
+    HIGH = 2
+
+
+TEXT = Text("hello world")
+NUMBER = Number(12345)
+REAL = Real(3.25)
+
+
+def test_count_allocations():
+    assert count_allocations(lambda: None, 100) == (0, 0)
+    allocated, freed = count_allocations(lambda: [object()], 100)
+    assert allocated >= 100
+    assert allocated == freed
+    assert count_allocations(lambda: None, 0) == (0, 0)
+
+
+def test_count_allocations_errors():
+    with pytest.raises(ValueError):
+        count_allocations(lambda: None, -1)
+    with pytest.raises(TypeError):
+        count_allocations(1)
+    with pytest.raises(ZeroDivisionError):
+        count_allocations(lambda: 1 / 0)
+    with pytest.raises(RuntimeError, match="already counted"):
+        count_allocations(lambda: count_allocations(lambda: None))
+
+
+@pytest.mark.allocations(extra=0)
+def test_passthrough_allocates_nothing(allocations):
+    plain = str(TEXT)
+    allocations(lambda: TEXT.startswith("he"), lambda: plain.startswith("he"))
+    allocations(lambda: NUMBER.to_bytes(4, "little"), lambda: (12345).to_bytes(4, "little"))
+
+
+@pytest.mark.allocations(extra=0)
+def test_enum_member_allocates_nothing(allocations):
+    allocations(lambda: Level.LOW + 1, lambda: Level.LOW)
+
+
+# The rewrap budgets are ceilings over Python 3.8 to 3.13, each made of the blocks
+# listed above its test; a version may take one of them from a free-list instead.
+# Every rewrap records the keyword arguments of `__init__` in a new `{}`.
+
+
+# the instance, the `{}` of keyword arguments, and the instance `__dict__` that
+# holds the records, as `int` subclasses cannot have slots for them
+@pytest.mark.allocations(at_most=3)
+def test_rewrap_int(allocations):
+    plain = 12345
+    allocations(lambda: NUMBER + 1, lambda: plain + 1)
+
+
+# the instance, as the `float` free-list only serves exact floats, and the `{}` of
+# keyword arguments
+@pytest.mark.allocations(at_most=2)
+def test_rewrap_float(allocations):
+    plain = 3.25
+    allocations(lambda: REAL * 2.0, lambda: plain * 2.0)
+
+
+# the instance, the character buffer that `str` subclasses keep apart from the
+# object, and the `{}` of keyword arguments
+@pytest.mark.allocations(at_most=3)
+def test_rewrap_str(allocations):
+    plain = str(TEXT)
+    allocations(lambda: TEXT.upper(), lambda: plain.upper())
+
+
+# as for `test_rewrap_str`
+@pytest.mark.allocations(at_most=3)
+def test_construct(allocations):
+    value = "hello"
+    allocations(lambda: Text(value), lambda: str(value))
@@ -0,0 +1,178 @@
+import subprocess
+import sys
+from pathlib import Path
+
+import pytest
+from conftest import LEAK_LIMIT, limit_leaks
+
+from newtype import NativeValidator, NewType
+
+
+TASKS = Path("/proc/self/task")
+ALNUM = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+
+
+class UserId(NewType(str), validator=NativeValidator(min_len=1, max_len=8, charset=ALNUM)):
+    def __init__(self, val: str) -> None:
+        self.seen = True
+
+
+class RawKey(NewType(bytes), validator=NativeValidator(max_len=4)):
+    pass
+
+
+class AdminId(UserId):
+    pass
+
+
+@limit_leaks(LEAK_LIMIT)
+def test_native_validator_single_value():
+    validator = NativeValidator(min_len=2, max_len=3, charset="ab")
+    validator("ab")
+    validator(b"aba")
+
+    with pytest.raises(ValueError, match="shorter than `min_len` = 2"):
+        validator("a")
+    with pytest.raises(ValueError, match="longer than `max_len` = 3"):
+        validator("abab")
+    with pytest.raises(ValueError, match="outside of `charset` at position 1"):
+        validator("ac")
+    with pytest.raises(ValueError, match="outside of `charset`"):
+        validator("aé")
+    with pytest.raises(TypeError, match="expected `str` or `bytes`"):
+        validator(12)
+
+
+def test_native_validator_arguments():
+    assert NativeValidator().max_len is None
+    assert NativeValidator(max_len=3).max_len == 3
+    with pytest.raises(ValueError):
+        NativeValidator(min_len=-1)
+    with pytest.raises(ValueError):
+        NativeValidator(min_len=3, max_len=2)
+    with pytest.raises(ValueError):
+        NativeValidator(charset="é")
+
+
+@limit_leaks(LEAK_LIMIT)
+def test_validator_runs_on_construction():
+    user_id = UserId("abc123")
+    assert user_id == "abc123"
+    assert user_id.seen
+    assert isinstance(user_id.upper(), UserId)
+
+    with pytest.raises(ValueError):
+        UserId("")
+    with pytest.raises(ValueError):
+        UserId("abc-123")
+    with pytest.raises(ValueError):
+        UserId("abc123").replace("abc", "abc-")
+
+
+def test_validator_is_inherited():
+    with pytest.raises(ValueError):
+        AdminId("way-too-long")
+    assert isinstance(AdminId("root"), AdminId)
+
+
+@limit_leaks(LEAK_LIMIT)
+def test_batch_preserves_order():
+    values = [f"u{i}" for i in range(100)]
+    user_ids = UserId.batch(values)
+
+    assert user_ids == values
+    assert all(type(user_id) is UserId for user_id in user_ids)
+    assert all(user_id.seen for user_id in user_ids)
+
+
+def test_batch_parallel_reports_lowest_failing_index():
+    values = [f"u{i % 1000}" for i in range(50_000)]
+    values[31_000] = "bad-1"
+    values[12_345] = "bad-2"
+
+    for _ in range(5):
+        with pytest.raises(ValueError, match=r"`values\[12345\]`: 'bad-2'"):
+            UserId.batch(values, workers=8)
+
+    values[12_345] = "ok"
+    with pytest.raises(ValueError, match=r"`values\[31000\]`"):
+        UserId.batch(values, workers=8)
+
+
+def test_batch_parallel_matches_sequential():
+    values = [f"id{i}" for i in range(40_000)]
+    assert UserId.batch(values, workers=8) == UserId.batch(values, workers=1)
+
+
+def test_batch_bytes_and_type_errors():
+    keys = RawKey.batch([b"a", b"bc", b"def"])
+    assert keys == [b"a", b"bc", b"def"]
+    assert all(isinstance(key, RawKey) for key in keys)
+
+    with pytest.raises(TypeError, match=r"`values\[1\]`: expected `str` or `bytes`"):
+        UserId.batch(["a", 1, "b"])
+
+
+def test_batch_without_validator():
+    class Name(NewType(str)):
+        def __init__(self, val: str) -> None:
+            if not val:
+                raise ValueError("empty")
+
+    assert Name.batch(["a", "b"]) == ["a", "b"]
+    with pytest.raises(ValueError, match="empty"):
+        Name.batch(["a", ""])
+
+
+def test_native_validator_is_immutable():
+    validator = NativeValidator(min_len=2)
+    with pytest.raises(TypeError, match="immutable"):
+        validator.__init__(min_len=0)
+    assert validator.min_len == 2
+    with pytest.raises(ValueError):
+        validator("a")
+
+
+@pytest.mark.skipif(not TASKS.is_dir(), reason="needs /proc")
+def test_batch_workers_are_started_once():
+    # in a new process, so that no earlier test has started the pool
+    code = (
+        "from pathlib import Path\n"
+        "from newtype import NativeValidator, NewType\n"
+        "class Id(NewType(str), validator=NativeValidator(max_len=8)):\n"
+        "    pass\n"
+        "def threads():\n"
+        "    return {task.name for task in Path('/proc/self/task').iterdir()}\n"
+        "values = [f'id{i}' for i in range(40_000)]\n"
+        "before = threads()\n"
+        "Id.batch(values, workers=4)\n"
+        "started = threads()\n"
+        "assert len(started - before) == 3, (before, started)\n"
+        "for _ in range(5):\n"
+        "    Id.batch(values, workers=4)\n"
+        "assert threads() == started, (started, threads())\n"
+    )
+    subprocess.run([sys.executable, "-c", code], check=True)
+
+
+def test_batch_goes_through_the_metaclass():
+    calls = []
+
+    class Counting(type):
+        def __call__(cls, *args, **kwargs):
+            calls.append(args)
+            return super().__call__(*args, **kwargs)
+
+    class Code(
+        NewType(str), metaclass=Counting, validator=NativeValidator(max_len=2, charset=ALNUM)
+    ):
+        pass
+
+    codes = Code.batch(["a", "bc"])
+    assert codes == ["a", "bc"]
+    assert all(type(code) is Code for code in codes)
+    assert calls == [("a",), ("bc",)]
+    with pytest.raises(ValueError, match=r"`values\[1\]`"):
+        Code.batch(["a", "toolong"])
+    with pytest.raises(ValueError, match="longer than `max_len`"):
+        Code("toolong")
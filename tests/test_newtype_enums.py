@@ -125,3 +125,39 @@ def test_severity():
     assert str(severity.value) == "4"
     with pytest.raises(ValueError, match=r"\d+ is not a valid Severity"):
         severity += 1
+
+
+class Level(NewType(int)):
+    CONSTRUCTED = 0
+
+    def __init__(self, value: int) -> None:
+        type(self).CONSTRUCTED += 1
+        if value < 0:
+            raise ValueError(f"{value} is negative")
+
+
+class Priority(Level, Enum):
+    LOW = 1
+    MEDIUM = 2
+    HIGH = 3
+
+    @classmethod
+    def _missing_(cls, value):
+        if value == 10:
+            return cls.HIGH
+        return None
+
+
+def test_enum_results_resolve_to_members_without_validation():
+    constructed = Level.CONSTRUCTED
+    assert Priority.LOW + 1 is Priority.MEDIUM
+    assert Priority.HIGH - 2 is Priority.LOW
+    assert Priority.MEDIUM * 1 is Priority.MEDIUM
+    assert Level.CONSTRUCTED == constructed
+
+
+def test_enum_results_without_member_go_through_enum():
+    assert Priority.HIGH + 7 is Priority.HIGH  # through `_missing_`
+    with pytest.raises(ValueError, match="4 is not a valid Priority"):
+        Priority.HIGH + 1
+    assert Priority(2) is Priority.MEDIUM
@@ -0,0 +1,133 @@
+import gc
+import weakref
+
+import pytest
+from conftest import LEAK_LIMIT, limit_leaks
+
+from newtype import NewType
+from newtype.extensions import NEWTYPE_FREELIST_STR, freelist_stats, set_freelist
+
+
+NEWTYPE_FREELIST_CLASSES = 100
+
+
+class Meters(NewType(float), freelist=8):
+    def __init__(self, val: float) -> None:
+        if val < 0:
+            raise ValueError("must not be negative")
+
+
+class Seconds(NewType(float)):
+    __slots__ = ()
+
+
+class Labelled(NewType(float), freelist=2):
+    def __init__(self, val: float, label: str = "") -> None:
+        self.label = label
+
+    def __del__(self) -> None:
+        type(self).deleted += 1
+
+    deleted = 0
+
+
+@limit_leaks(LEAK_LIMIT)
+def test_freelist_reuses_instances():
+    for _ in range(100):
+        total = Meters(1.5) + Meters(2.0)
+        assert type(total) is Meters
+        assert total == 3.5
+
+    stats = Meters.freelist_stats()
+    assert stats["capacity"] == 8
+    assert 0 < stats["size"] <= 8
+    assert stats["hits"] > stats["misses"]
+    assert 0.0 < stats["hit_rate"] <= 1.0
+
+
+def test_reused_instances_are_fresh():
+    Labelled.deleted = 0
+    for i in range(10):
+        value = Labelled(float(i), label=str(i))
+        assert value.label == str(i)
+        assert not hasattr(Labelled(1.0), "other")
+        value.other = i
+    del value
+    gc.collect()
+    # every reused instance is finalized again; `__init__` keeps the last one bound
+    assert Labelled.deleted == 19
+    assert Labelled.freelist_stats()["hits"] > 0
+
+
+def test_no_freelist():
+    assert Seconds.freelist_stats() is None
+    set_freelist(Seconds, 0)
+    assert freelist_stats(Seconds) is None
+
+
+def test_freelist_is_not_inherited():
+    class Kilometers(Meters):
+        pass
+
+    class Miles(Meters, freelist=4):
+        pass
+
+    assert Kilometers(1.0) + Kilometers(2.0) == 3.0
+    assert Kilometers.freelist_stats() is None
+    assert Miles(1.0) + Miles(2.0) == 3.0
+    assert Miles.freelist_stats()["capacity"] == 4
+    assert Meters.freelist_stats()["capacity"] == 8
+
+
+def test_freelist_of_a_newtype_base_is_its_own():
+    class Yards(NewType(Meters)):
+        pass
+
+    assert NEWTYPE_FREELIST_STR not in vars(Yards)
+    assert Yards.freelist_stats() is None
+
+
+def test_classes_with_freelists_are_collected():
+    # more classes than the free-lists once had room for, each keeping blocks
+    refs = []
+    for i in range(NEWTYPE_FREELIST_CLASSES):
+
+        class Scratch(NewType(float), freelist=2):
+            pass
+
+        values = [Scratch(float(i)) for _ in range(3)]
+        del values
+        assert Scratch.freelist_stats()["size"] == 2
+        refs.append(weakref.ref(Scratch))
+    del Scratch
+    gc.collect()
+    assert all(ref() is None for ref in refs)
+
+
+def test_resize_and_remove():
+    class Scratch(NewType(float)):
+        pass
+
+    set_freelist(Scratch, 4)
+    values = [Scratch(float(i)) for i in range(6)]
+    del values
+    assert Scratch.freelist_stats()["size"] <= 4
+
+    set_freelist(Scratch, 1)
+    assert Scratch.freelist_stats()["size"] <= 1
+    set_freelist(Scratch, 0)
+    assert Scratch.freelist_stats() is None
+    assert Scratch(2.0) * 2 == 4.0
+
+
+def test_freelist_errors():
+    with pytest.raises(TypeError, match="vary in size"):
+
+        class Count(NewType(int), freelist=8):
+            pass
+
+    with pytest.raises(TypeError, match="not a heap type"):
+        set_freelist(float, 8)
+
+    with pytest.raises(ValueError, match="must not be negative"):
+        set_freelist(Seconds, -1)
@@ -0,0 +1,154 @@
+import pytest
+from conftest import LEAK_LIMIT, limit_leaks
+
+from newtype import FusedChain, NewType
+
+
+class EmailStr(NewType(str)):
+    inits = 0
+
+    def __init__(self, val: str, strict: bool = False) -> None:
+        type(self).inits += 1
+        if "@" not in val:
+            raise ValueError(f"not an email: {val!r}")
+
+    def title(self) -> str:
+        return "Email: " + super().title()
+
+
+@limit_leaks(LEAK_LIMIT)
+def test_fused_chain_validates_once():
+    email = EmailStr(" A@B.COM. ")
+    EmailStr.inits = 0
+
+    chain = email.fused().strip().lower().replace(".", "!")
+    assert isinstance(chain, FusedChain)
+    assert EmailStr.inits == 0
+
+    result = chain.materialize()
+    assert type(result) is EmailStr
+    assert result == "a@b!com!"
+    assert EmailStr.inits == 1
+    assert chain.materialize() is result
+    assert EmailStr.inits == 1
+
+
+def test_fused_chain_keeps_init_args():
+    email = EmailStr("A@B.COM", True)
+    result = email.fused().lower().materialize()
+    assert result._newtype_init_args_ == (True,)
+
+
+def test_fused_chain_escapes():
+    email = EmailStr("A@B.COM")
+
+    assert email.fused().lower() == "a@b.com"
+    assert hash(email.fused().lower()) == hash("a@b.com")
+    assert str(email.fused().lower()) == "a@b.com"
+    assert repr(email.fused().lower()) == "'a@b.com'"
+    assert f"{email.fused().lower():>8}" == " a@b.com"
+    assert len(email.fused().lower()) == 7
+    assert "@" in email.fused().lower()
+    assert list(email.fused().lower())[0] == "a"
+    assert bool(email.fused().lower())
+
+
+def test_fused_chain_error_at_escape():
+    chain = EmailStr("a@b.com").fused().replace("@", "-")
+    with pytest.raises(ValueError, match="not an email"):
+        chain.materialize()
+    with pytest.raises(ValueError, match="not an email"):
+        assert chain == "a-b.com"
+
+
+def test_fused_chain_non_base_results_pass_through():
+    email = EmailStr("a@b.com")
+    assert email.fused().upper().split("@") == ["A", "B.COM"]
+    assert email.fused().find("@") == 1
+
+
+def test_fused_chain_overridden_method_materialises():
+    email = EmailStr("a@b.com")
+    EmailStr.inits = 0
+
+    result = email.fused().upper().title()
+    assert type(result) is EmailStr
+    assert result == "Email: A@B.Com"
+    assert EmailStr.inits == 2
+
+
+def test_fused_chain_validates_lazy_receiver():
+    class LazyEmail(EmailStr, validation="lazy"):
+        pass
+
+    with pytest.raises(ValueError):
+        LazyEmail("nope").fused()
+
+
+class Price(NewType(int)):
+    inits = 0
+
+    def __init__(self, val: int) -> None:
+        type(self).inits += 1
+        if val < 0:
+            raise ValueError(f"negative price: {val}")
+
+
+def test_fused_chain_operators_are_steps():
+    price = Price(10)
+    Price.inits = 0
+
+    chain = -(price.fused() * 3 - 40) // 2 + 1
+    assert isinstance(chain, FusedChain)
+    assert Price.inits == 0
+    result = chain.materialize()
+    assert type(result) is Price
+    assert result == 6
+    assert Price.inits == 1
+
+    assert (100 - price.fused()).materialize() == 90
+    assert (price.fused() + price.fused()).materialize() == 20
+    assert (abs(-price.fused()) | 1).materialize() == 11
+    with pytest.raises(ValueError, match="negative price: -10"):
+        (-price.fused()).materialize()
+
+
+def test_fused_chain_indexing_and_string_operators():
+    email = EmailStr("a@b.com")
+    EmailStr.inits = 0
+
+    chain = ("x" + email.fused()[1:] * 2).replace("x", "")
+    assert isinstance(chain, FusedChain)
+    with pytest.raises(ValueError, match="not an email"):
+        (email.fused()[2:] + "!").materialize()
+    assert EmailStr.inits == 1
+    assert chain.materialize() == "@b.com@b.com"
+
+
+def test_fused_chain_conversions_escape():
+    price = Price(10)
+
+    assert int(price.fused() + 1) == 11
+    assert float(price.fused()) == 10.0
+    assert [0, 1, 2][Price(1).fused()] == 1
+    assert price.fused() < 11
+    assert price.fused() >= 10
+    with pytest.raises(ValueError, match="negative price"):
+        assert int(price.fused() - 11)
+
+
+def test_fused_chain_overridden_operator_materialises():
+    class Cents(Price):
+        def __add__(self, other: int) -> int:
+            return int.__add__(self, other * 100)
+
+    Cents.inits = 0
+    result = (Cents(1).fused() + 1).materialize()
+    assert result == 101
+    assert type(result) is Cents
+
+
+def test_fused_chain_is_not_a_base_instance():
+    chain = EmailStr("a@b.com").fused()
+    assert not isinstance(chain, str)
+    assert isinstance(chain.materialize(), str)
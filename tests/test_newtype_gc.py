@@ -0,0 +1,75 @@
+import gc
+import weakref
+
+from newtype import NewType
+
+
+def make_class(bound: int) -> type:
+    class BoundedInt(NewType(int)):
+        MAX_VALUE = bound
+
+        def __init__(self, value: int) -> None:
+            if value >= self.MAX_VALUE:
+                raise ValueError(f"{value} is not below {self.MAX_VALUE}")
+
+    return BoundedInt
+
+
+class Bounded(NewType(int)):
+    __CONCRETE__ = weakref.WeakValueDictionary()
+
+    def __class_getitem__(cls, bound: int) -> type:
+        if bound not in cls.__CONCRETE__:
+
+            class Concrete(cls):
+                MAX_VALUE = bound
+
+            cls.__CONCRETE__[bound] = Concrete
+        return cls.__CONCRETE__[bound]
+
+
+def test_dynamic_classes_are_collected():
+    refs = []
+    for i in range(20):
+        cls = make_class(i + 1)
+        assert cls(0) + 0 == 0
+        refs.append(weakref.ref(cls))
+    del cls
+    gc.collect()
+    assert all(ref() is None for ref in refs)
+
+
+def test_class_getitem_cache_empties():
+    for i in range(20):
+        assert Bounded[i](i) == i
+    gc.collect()
+    # `Bounded.__init__` stays bound to the last subclass it was looked up on
+    assert len(Bounded.__CONCRETE__) <= 1
+
+
+def test_init_descriptor_participates_in_gc():
+    cls = make_class(10)
+    init = vars(cls)["__init__"]
+    value = cls(3)
+
+    assert gc.is_tracked(init)
+    assert cls in gc.get_referents(init)
+    assert value in gc.get_referents(init)
+
+
+def test_init_descriptor_supports_weakrefs():
+    cls = make_class(10)
+    ref = weakref.ref(vars(cls)["__init__"])
+    assert ref() is vars(cls)["__init__"]
+
+    del cls
+    gc.collect()
+    assert ref() is None
+
+
+def test_method_descriptor_participates_in_gc():
+    method = vars(make_class(10))["__add__"]
+
+    assert gc.is_tracked(method)
+    assert int.__add__ in gc.get_referents(method)
+    assert "__add__" in gc.get_referents(method)
@@ -30,3 +30,18 @@ def test_new_init_method():
     for i in range(100):
         g.add_one()
         assert g.val == init_num + i + 1
+
+
+class Traced(NewType(str)):
+    missing = []
+
+    def __getattr__(self, name):
+        Traced.missing.append(name)
+        raise AttributeError(name)
+
+
+def test_recording_init_args_does_not_fall_back_to_getattr():
+    Traced.missing.clear()
+    traced = Traced("x")
+    assert traced.upper() == "X"
+    assert Traced.missing == []
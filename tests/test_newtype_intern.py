@@ -0,0 +1,158 @@
+import gc
+
+import pytest
+from conftest import LEAK_LIMIT, limit_leaks
+
+from newtype import NewType
+from newtype.newtype import NEWTYPE_INTERN_MAX, InternPool, KeyedInternPool
+
+
+class CountryCode(NewType(str), intern=True):
+    inits = 0
+
+    def __init__(self, val: str) -> None:
+        type(self).inits += 1
+        if len(val) != 2:
+            raise ValueError(f"not a country code: {val!r}")
+
+
+class Severity(NewType(int), intern=True):
+    pass
+
+
+class Region(CountryCode):
+    pass
+
+
+@limit_leaks(LEAK_LIMIT)
+def test_intern_returns_canonical_instance():
+    CountryCode.inits = 0
+    first = CountryCode("SG")
+    second = CountryCode("SG")
+
+    assert first is second
+    assert CountryCode("MY") is not first
+    assert CountryCode.inits == 2
+
+
+def test_intern_rewraps_share_instances():
+    lower = CountryCode("SG").lower()
+    assert lower is CountryCode("sg")
+    assert CountryCode("SG").upper() is CountryCode("SG")
+
+
+def test_intern_failed_validation_is_not_pooled():
+    with pytest.raises(ValueError):
+        CountryCode("SGP")
+    with pytest.raises(ValueError):
+        CountryCode("SGP")
+
+
+def test_intern_is_weak_when_possible():
+    code = CountryCode("XY")
+    assert "XY" in CountryCode._newtype_pool_
+    del code
+    CountryCode("ZZ")  # descriptors hold on to the last instance they bound
+    gc.collect()
+    assert "XY" not in CountryCode._newtype_pool_
+
+
+def test_intern_without_weakrefs_uses_bounded_pool():
+    assert type(Severity._newtype_pool_) is InternPool
+    assert Severity._newtype_pool_.maxsize == NEWTYPE_INTERN_MAX
+    assert Severity(3) is Severity(3)
+    assert Severity(3) + 1 is Severity(4)
+
+
+def test_intern_pool_evicts_oldest():
+    class Port(NewType(int), intern=3):
+        pass
+
+    first = Port(1)
+    for value in range(2, 1000):
+        Port(value)
+    assert len(Port._newtype_pool_) == 3
+    assert list(Port._newtype_pool_) == [997, 998, 999]
+    assert Port(999) is Port(999)
+
+    assert Port(1) == first
+    assert Port(1) is not first
+    assert Port(1) is Port(1)
+    assert 997 not in Port._newtype_pool_
+
+
+def test_intern_bound_is_inherited():
+    class Port(NewType(int), intern=2):
+        pass
+
+    class SubPort(Port):
+        pass
+
+    assert SubPort._newtype_pool_.maxsize == 2
+    assert SubPort._newtype_pool_ is not Port._newtype_pool_
+
+
+@pytest.mark.parametrize("intern", [0, -1, 1.5, "yes"])
+def test_intern_bound_errors(intern):
+    with pytest.raises(ValueError, match="`intern` must be a bool or a positive int"):
+
+        class Port(NewType(int), intern=intern):
+            pass
+
+
+def test_intern_subclass_has_own_pool():
+    assert Region("SG") is Region("SG")
+    assert Region("SG") is not CountryCode("SG")
+    assert type(Region("SG")) is Region
+
+
+def test_intern_only_for_exact_base_values():
+    class Tag(NewType(str), intern=True):
+        def __init__(self, val: str, suffix: str = "") -> None:
+            pass
+
+    assert Tag("a", "x") is not Tag("a", "x")
+    assert Tag(Tag("a")) is not Tag("a")
+    assert Tag("a") is Tag("a")
+
+
+def test_intern_can_be_disabled_in_subclass():
+    class Plain(CountryCode, intern=False):
+        pass
+
+    assert Plain._newtype_pool_ is None
+    assert Plain("SG") is not Plain("SG")
+
+
+def test_intern_unhashable_base():
+    with pytest.raises(TypeError, match="unhashable"):
+
+        class Interned(NewType(list), intern=True):
+            pass
+
+
+def test_intern_tells_signed_zeros_apart():
+    class Ratio(NewType(float), intern=True):
+        pass
+
+    zero = Ratio(0.0)
+    negative_zero = Ratio(-0.0)
+
+    assert negative_zero is not zero
+    assert repr(negative_zero) == "-0.0"
+    assert Ratio(0.0) is zero
+    assert Ratio(-0.0) is negative_zero
+
+
+def test_intern_tells_element_types_apart():
+    class Pair(NewType(tuple), intern=True):
+        pass
+
+    ints = Pair((1, 2))
+    mixed = Pair((1.0, 2))
+
+    assert mixed is not ints
+    assert type(mixed[0]) is float
+    assert Pair((1, 2)) is ints
+    assert Pair((1.0, 2)) is mixed
+    assert type(Pair._newtype_pool_) is KeyedInternPool
@@ -0,0 +1,109 @@
+import pytest
+from conftest import LEAK_LIMIT, limit_leaks
+
+from newtype import NewType, func_is_invariant, newtype_invariant
+from newtype.extensions import NEWTYPE_INIT_ARGS_STR, NEWTYPE_INIT_KWARGS_STR
+
+
+class EmailStr(NewType(str)):
+    __newtype_invariants__ = ("strip",)
+    inits = 0
+
+    def __init__(self, val: str, domain: str = "example.com", *, strict: bool = False) -> None:
+        type(self).inits += 1
+        if "@" not in val:
+            raise ValueError(f"not an email: {val!r}")
+
+    @newtype_invariant
+    def lower(self) -> str:
+        return super().lower()
+
+    def title(self) -> str:
+        return super().title()
+
+
+class PositiveInt(NewType(int)):
+    __newtype_invariants__ = ("__mul__", "__add__")
+    inits = 0
+
+    def __init__(self, val: int) -> None:
+        type(self).inits += 1
+        if val <= 0:
+            raise ValueError("must be positive")
+
+
+class WorkEmail(EmailStr):
+    pass
+
+
+def test_decorator_marks_function():
+    def f():
+        pass
+
+    assert not func_is_invariant(f)
+    assert newtype_invariant(f) is f
+    assert func_is_invariant(f)
+
+
+@limit_leaks(LEAK_LIMIT)
+def test_invariant_methods_skip_init():
+    email = EmailStr(" A@B.COM ", "b.com", strict=True)
+    EmailStr.inits = 0
+
+    lowered = email.lower()
+    assert type(lowered) is EmailStr
+    assert lowered == " a@b.com "
+    assert EmailStr.inits == 0
+
+    stripped = lowered.strip()
+    assert stripped == "a@b.com"
+    assert EmailStr.inits == 0
+    assert getattr(stripped, NEWTYPE_INIT_ARGS_STR) == ("b.com",)
+    assert getattr(stripped, NEWTYPE_INIT_KWARGS_STR) == {"strict": True}
+
+
+def test_other_methods_still_validate():
+    email = EmailStr("a@b.com")
+    EmailStr.inits = 0
+
+    assert type(email.upper()) is EmailStr
+    assert EmailStr.inits == 1
+    with pytest.raises(ValueError, match="not an email"):
+        email.replace("@", "-")
+
+
+def test_undecorated_override_still_validates():
+    email = EmailStr("a@b.com")
+    EmailStr.inits = 0
+    assert type(email.title()) is EmailStr
+    assert EmailStr.inits == 1
+
+
+def test_invariant_dunders():
+    x = PositiveInt(3)
+    PositiveInt.inits = 0
+
+    product = x * PositiveInt(4)
+    assert product == 12
+    assert type(product) is PositiveInt
+    assert type(x + 1) is PositiveInt
+    assert PositiveInt.inits == 1  # only `PositiveInt(4)`
+
+    with pytest.raises(ValueError):
+        x - 5
+
+
+def test_invariants_are_inherited():
+    email = WorkEmail(" a@b.com ")
+    WorkEmail.inits = 0
+    assert type(email.strip()) is WorkEmail
+    assert WorkEmail.inits == 0
+
+
+def test_lazy_invariant_validates_receiver_first():
+    class LazyEmail(EmailStr, validation="lazy"):
+        pass
+
+    with pytest.raises(ValueError, match="not an email"):
+        LazyEmail("nope").lower()
+    assert LazyEmail("a@b.com").lower() == "a@b.com"
@@ -0,0 +1,188 @@
+import pytest
+from conftest import LEAK_LIMIT, limit_leaks
+
+from newtype import NativeValidator, NewType
+from newtype.extensions import NEWTYPE_PENDING_STR
+
+
+class Counted(NewType(str), validation="lazy"):
+    calls = 0
+
+    def __init__(self, val: str) -> None:
+        type(self).calls += 1
+        if not val.isalnum():
+            raise ValueError(f"not alphanumeric: {val!r}")
+
+
+class Code(NewType(str), validator=NativeValidator(max_len=4), validation="lazy"):
+    pass
+
+
+class SubCounted(Counted):
+    pass
+
+
+@limit_leaks(LEAK_LIMIT)
+def test_lazy_construction_does_not_validate():
+    Counted.calls = 0
+    values = [Counted("bad value") for _ in range(10)]
+
+    assert Counted.calls == 0
+    assert str(values[0]) == "bad value"
+    assert all(getattr(value, NEWTYPE_PENDING_STR) == (("bad value",), None) for value in values)
+    # the arguments are recorded once, in the pending record only
+    assert vars(values[0]) == {NEWTYPE_PENDING_STR: (("bad value",), None)}
+
+
+@limit_leaks(LEAK_LIMIT)
+def test_lazy_validates_on_first_use():
+    Counted.calls = 0
+    value = Counted("abc")
+
+    assert isinstance(value.upper(), Counted)
+    assert Counted.calls == 1
+    assert not hasattr(value, NEWTYPE_PENDING_STR)
+
+    value.lower()
+    assert Counted.calls == 1
+
+
+def test_lazy_error_at_point_of_use():
+    value = Counted("a b")
+
+    for _ in range(3):
+        with pytest.raises(ValueError, match="not alphanumeric: 'a b'"):
+            value.upper()
+    assert getattr(value, NEWTYPE_PENDING_STR) == (("a b",), None)
+
+
+def test_lazy_comparisons_and_hash_validate():
+    for compare in (
+        lambda value: value == "a b",
+        lambda value: value != "a b",
+        lambda value: value < "z",
+        lambda value: value >= "a",
+        hash,
+        lambda value: {value: 1},
+        lambda value: value in {"a b"},
+    ):
+        with pytest.raises(ValueError, match="not alphanumeric: 'a b'"):
+            compare(Counted("a b"))
+
+    value = Counted("abc")
+    assert value == "abc"
+    assert hash(value) == hash("abc")
+    assert type(hash(value)) is int
+    assert not hasattr(value, NEWTYPE_PENDING_STR)
+    assert {value: 1}["abc"] == 1
+
+
+def test_lazy_guarded_results_are_not_rewrapped():
+    class Even(NewType(int), validation="lazy"):
+        def __init__(self, val: int) -> None:
+            if val % 2:
+                raise ValueError(f"odd: {val}")
+
+    value = Even(4)
+    assert type(value == 4) is bool
+    assert type(hash(value)) is int
+    assert type(value < 6) is bool
+    with pytest.raises(ValueError, match="odd: 3"):
+        hash(Even(3))
+
+
+def test_lazy_own_comparisons_are_kept():
+    class Folded(NewType(str), validation="lazy"):
+        def __init__(self, val: str) -> None:
+            if not val:
+                raise ValueError("empty")
+
+        def __eq__(self, other: object) -> bool:
+            return str.lower(self) == str(other).lower()
+
+        __hash__ = str.__hash__
+
+    assert Folded("ABC") == "abc"
+    with pytest.raises(ValueError, match="empty"):
+        Folded("") == ""  # noqa: B015
+
+
+def test_lazy_validates_receiver_of_class_access():
+    with pytest.raises(ValueError, match="not alphanumeric"):
+        Counted.upper(Counted("a b"))
+    assert Counted.upper(Counted("ab")) == "AB"
+
+
+def test_lazy_keeps_keyword_arguments():
+    class Bounded(NewType(str), validation="lazy"):
+        def __init__(self, val: str, *, limit: int) -> None:
+            if len(val) > limit:
+                raise ValueError(f"longer than {limit}")
+
+    value = Bounded("abc", limit=2)
+    assert getattr(value, NEWTYPE_PENDING_STR) == (("abc",), {"limit": 2})
+    with pytest.raises(ValueError, match="longer than 2"):
+        value.validate()
+
+    value = Bounded("ab", limit=2)
+    assert value.upper() == "AB"
+    assert getattr(value.upper(), NEWTYPE_PENDING_STR) == (("AB",), {"limit": 2})
+    assert value._newtype_init_kwargs_ == {"limit": 2}
+
+
+def test_lazy_explicit_validate():
+    assert Counted("abc").validate() == "abc"
+    with pytest.raises(ValueError, match="not alphanumeric"):
+        Counted("a-c").validate()
+
+    value = Counted("ok")
+    assert value.validate() is value
+    assert value.validate() is value
+
+
+def test_lazy_native_validator():
+    code = Code("too-long")
+    assert str(code) == "too-long"
+    with pytest.raises(ValueError, match="longer than `max_len` = 4"):
+        code.upper()
+
+    assert Code.batch(["abc", "too-long"])[0] == "abc"
+    with pytest.raises(ValueError):
+        Code.batch(["too-long"])[0].validate()
+
+
+def test_lazy_is_inherited_and_overridable():
+    SubCounted.calls = 0
+    SubCounted("a b")
+    assert SubCounted.calls == 0
+
+    class Eager(Counted, validation="eager"):
+        pass
+
+    with pytest.raises(ValueError):
+        Eager("a b")
+
+
+def test_validation_mode_errors():
+    with pytest.raises(ValueError, match="`validation` must be one of"):
+
+        class Bad(NewType(str), validation="sometimes"):
+            pass
+
+    with pytest.raises(TypeError, match="no `__dict__`"):
+
+        class Slotted(NewType(str), validation="lazy"):
+            __slots__ = ()
+
+    class SlottedPending(NewType(str), validation="lazy"):
+        __slots__ = (NEWTYPE_PENDING_STR,)
+
+    assert SlottedPending("abc").upper() == "ABC"
+
+
+def test_eager_validate_is_noop():
+    class Eager(NewType(str)):
+        pass
+
+    value = Eager("abc")
+    assert value.validate() is value
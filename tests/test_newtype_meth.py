@@ -1,3 +1,6 @@
+import weakref
+
+import pytest
 from conftest import LEAK_LIMIT, limit_leaks
 
 from newtype import NewType
@@ -18,3 +21,99 @@ def test_new_type_method():
     assert g.add_one() is None
 
     assert g.val == 6
+
+
+class Tag:
+    pass
+
+
+class Box:
+    def __init__(self, val):
+        self.val = val
+
+    def tag(self):
+        return Tag()
+
+    def clone(self):
+        return Box(self.val)
+
+    def add(self, *vals, extra=0):
+        return Box(self.val + sum(vals) + extra)
+
+
+class Boxed(NewType(Box)):
+    pass
+
+
+def test_passthrough_result_is_not_leaked():
+    ref = weakref.ref(Boxed(Box(1)).tag())
+    assert ref() is None
+
+
+def test_unbound_call_on_base_value_is_not_leaked():
+    box = Box(1)
+    ref = weakref.ref(box)
+    assert type(Boxed.clone(box)) is Box
+    del box
+    assert ref() is None
+
+
+class Text(NewType(str)):
+    pass
+
+
+def test_functions_called_with_positional_arguments():
+    boxed = Boxed(Box(1))
+    assert isinstance(boxed.add(1, 2), Boxed)
+    assert boxed.add(1, 2).val == 4
+    assert boxed.add(*range(10)).val == 46
+    assert boxed.add(1, extra=10).val == 12
+    assert Boxed.add(boxed, 1).val == 2
+
+
+def test_method_descriptors_called_with_positional_arguments():
+    text = Text("a,b")
+    assert text.split(",") == ["a", "b"]
+    assert text.split(sep=",") == ["a", "b"]
+    assert Text.upper(text) == "A,B"
+    assert isinstance(text.replace(",", ";"), Text)
+    with pytest.raises(TypeError):
+        text.split(1)
+
+
+def test_slot_wrappers_called_with_positional_arguments():
+    text = Text("a")
+    assert isinstance(text.__add__("b"), Text)
+    assert text.__add__("b") == "ab"
+    assert text + "b" == "ab"
+    assert text.__mul__(2) == "aa"
+
+
+class Probe:
+    looked_up = []
+
+    def __getattribute__(self, name):
+        Probe.looked_up.append(name)
+        return object.__getattribute__(self, name)
+
+
+class Source:
+    def probe(self):
+        return Probe()
+
+
+class Sourced(NewType(Source)):
+    pass
+
+
+def test_results_returned_as_they_are_are_not_inspected():
+    Probe.looked_up.clear()
+    assert type(Sourced(Source()).probe()) is Probe
+    assert "__dict__" not in Probe.looked_up
+    assert "__slots__" not in Probe.looked_up
+
+
+def test_rewrapped_results_keep_their_attributes():
+    added = Boxed(Box(1)).add(1)
+    assert isinstance(added, Boxed)
+    assert vars(added)["val"] == 2
@@ -0,0 +1,77 @@
+import sys
+
+import pytest
+
+import newtype
+from newtype import NewType, NewTypeProfiler
+from newtype.extensions import newtypemethod
+
+
+HAS_MONITORING = hasattr(sys, "monitoring")
+
+
+class Email(NewType(str)):
+    def __init__(self, val: str) -> None:
+        if "@" not in val:
+            raise ValueError(f"{val!r} is not an email address")
+
+
+def calls(profiler):
+    return {
+        cls: {kind: totals["calls"] for kind, totals in kinds.items()}
+        for cls, kinds in profiler.results().items()
+    }
+
+
+@pytest.mark.skipif(not HAS_MONITORING, reason="needs sys.monitoring")
+def test_profiler_sorts_calls_by_kind():
+    if not HAS_MONITORING:
+        return
+    with NewTypeProfiler() as profiler:
+        email = Email("a@b.c")
+        for _ in range(3):
+            email.upper()
+        email.startswith("a")
+        with pytest.raises(ValueError, match="is not an email address"):
+            Email("nobody")
+        with pytest.raises(ValueError, match="is not an email address"):
+            email.replace("@", "")
+    email.lower()
+
+    assert calls(profiler) == {Email: {"validation": 2, "rewrap": 3, "passthrough": 2}}
+    assert all(
+        totals["seconds"] > 0 for kinds in profiler.results().values() for totals in kinds.values()
+    )
+
+
+@pytest.mark.skipif(not HAS_MONITORING, reason="needs sys.monitoring")
+def test_profiler_frees_its_tool_id():
+    if not HAS_MONITORING:
+        return
+    profiler = NewTypeProfiler().start()
+    tool_id = profiler.tool_id
+    assert sys.monitoring.get_tool(tool_id) == "newtype"
+    with pytest.raises(RuntimeError, match="running already"):
+        profiler.start()
+    profiler.stop()
+    assert sys.monitoring.get_tool(tool_id) is None
+    assert profiler.tool_id is None
+
+
+@pytest.mark.skipif(not HAS_MONITORING, reason="needs sys.monitoring")
+def test_profiler_restores_the_stats_flag():
+    if not HAS_MONITORING:
+        return
+    newtype.reset_stats()
+    with NewTypeProfiler():
+        assert newtypemethod.set_stats_enabled(True) is True
+    assert newtypemethod.set_stats_enabled(False) is False
+    newtype.reset_stats()
+
+
+@pytest.mark.skipif(HAS_MONITORING, reason="sys.monitoring is available")
+def test_profiler_needs_sys_monitoring():
+    if HAS_MONITORING:
+        return
+    with pytest.raises(RuntimeError, match="needs `sys.monitoring`"):
+        NewTypeProfiler().start()
@@ -0,0 +1,217 @@
+import tracemalloc
+
+import pytest
+from conftest import LEAK_LIMIT, limit_leaks
+
+from newtype import NewType, newtype_invariant
+
+
+class ValidatedList(NewType(list)):
+    def __init__(self, items=()) -> None:
+        if any(item is None for item in self):
+            raise ValueError("None is not allowed")
+
+
+class Table(NewType(dict)):
+    pass
+
+
+class Tags(NewType(set)):
+    pass
+
+
+def make(cls, base, contents):
+    inst = cls()
+    base.update(inst, contents) if base is not list else list.extend(inst, contents)
+    return inst
+
+
+@limit_leaks(LEAK_LIMIT)
+def test_list_rewraps_keep_contents():
+    items = make(ValidatedList, list, range(5))
+
+    for result, expected in [
+        (items.copy(), [0, 1, 2, 3, 4]),
+        (items[1:3], [1, 2]),
+        (items + [5], [0, 1, 2, 3, 4, 5]),
+        (items * 2, [0, 1, 2, 3, 4] * 2),
+    ]:
+        assert type(result) is ValidatedList
+        assert result == expected
+    assert items == [0, 1, 2, 3, 4]
+
+
+@limit_leaks(LEAK_LIMIT)
+def test_dict_and_set_rewraps_keep_contents():
+    table = make(Table, dict, {"a": 1})
+    assert type(table.copy()) is Table
+    assert table.copy() == {"a": 1}
+    assert table | {"b": 2} == {"a": 1, "b": 2}
+
+    tags = make(Tags, set, {1, 2})
+    assert type(tags | {3}) is Tags
+    assert tags | {3} == {1, 2, 3}
+    assert tags.copy() == {1, 2}
+    assert tags - {1} == {2}
+
+
+def test_shared_results_are_not_moved():
+    shared = [1, 2, 3]
+
+    class Borrowing(NewType(list)):
+        def __init__(self, items=()) -> None:
+            pass
+
+        @newtype_invariant
+        def copy(self):
+            return shared
+
+    result = make(Borrowing, list, [9]).copy()
+    assert shared == [1, 2, 3]
+    assert result == [1, 2, 3]
+    assert result is not shared
+
+
+def test_init_that_fills_the_instance_is_respected():
+    class Doubled(NewType(list)):
+        def __init__(self, items=()) -> None:
+            list.__init__(self, [item * 2 for item in items])
+
+    doubled = Doubled([1, 2])
+    assert doubled == [2, 4]
+    assert doubled.copy() == [4, 8]
+
+
+def test_init_validates_rewrapped_contents():
+    items = make(ValidatedList, list, [1, 2])
+
+    for rewrap in (
+        lambda: items + [None],
+        lambda: items * 1 + [None],
+        lambda: make(ValidatedList, list, [None, 1])[:1],
+    ):
+        with pytest.raises(ValueError, match="None is not allowed"):
+            rewrap()
+
+    class NoNone(NewType(set)):
+        def __init__(self, items=()) -> None:
+            if None in self:
+                raise ValueError("None is not allowed")
+
+    tags = make(NoNone, set, {1})
+    assert tags | {2} == {1, 2}
+    with pytest.raises(ValueError, match="None is not allowed"):
+        tags | {None}
+
+
+def test_init_receives_the_contents_too():
+    seen = []
+
+    class Recording(NewType(list)):
+        def __init__(self, items=()) -> None:
+            seen.append((list(self), list(items)))
+
+    make(Recording, list, [1, 2]).copy()
+    assert seen[-1] == ([1, 2], [1, 2])
+
+
+def test_large_list_copy():
+    items = make(ValidatedList, list, range(100_000))
+    copied = items.copy()
+    assert len(copied) == 100_000
+    assert copied[-1] == 99_999
+
+
+def test_subclass_init_receives_the_contents_too():
+    seen = []
+
+    class Recording(NewType(list)):
+        def __init__(self, items=()) -> None:
+            seen.append((list(self), list(items)))
+
+    class Inheriting(Recording):
+        pass
+
+    make(Inheriting, list, [1, 2]).copy()
+    assert seen[-1] == ([1, 2], [1, 2])
+
+
+def test_subclass_of_a_filling_init_receives_the_contents():
+    class Filling(NewType(list)):
+        def __init__(self, items=()) -> None:
+            list.__init__(self, items)
+
+    class Checking(Filling):
+        def __init__(self, items=()) -> None:
+            if any(item is None for item in self):
+                raise ValueError("None is not allowed")
+
+    assert Filling([1]) + [None] == [1, None]
+    with pytest.raises(ValueError, match="None is not allowed"):
+        make(Checking, list, [1]) + [None]
+
+
+def peak_bytes(operation):
+    tracemalloc.start()
+    try:
+        operation()
+        return tracemalloc.get_traced_memory()[1]
+    finally:
+        tracemalloc.stop()
+
+
+LARGE = 100_000
+
+
+def test_unshared_results_are_moved_not_copied():
+    class Items(NewType(list)):
+        pass
+
+    plain_dict = {i: i for i in range(LARGE)}
+
+    class Table(NewType(dict)):
+        def copy(self):
+            return plain_dict.copy()
+
+    class Tags(NewType(set)):
+        pass
+
+    class Checked(NewType(list)):
+        _newtype_init_reads_value_ = False
+
+        def __init__(self, items=()) -> None:
+            assert None not in self
+
+    items = make(Items, list, range(LARGE))
+    checked = make(Checked, list, range(LARGE))
+    plain_list = list(range(LARGE))
+    tags = make(Tags, set, range(LARGE))
+    plain_set = set(range(LARGE))
+
+    # the result of the base method is the only copy made
+    for rewrap, plain in [
+        (lambda: items + [1], lambda: plain_list + [1]),
+        (lambda: checked + [1], lambda: plain_list + [1]),
+        (lambda: Table().copy(), lambda: plain_dict.copy()),
+        (lambda: tags | {-1}, lambda: plain_set | {-1}),
+    ]:
+        assert peak_bytes(rewrap) < 1.5 * peak_bytes(plain)
+
+    assert items + [1] == plain_list + [1]
+    assert checked + [1] == plain_list + [1]
+    assert Table().copy() == plain_dict
+    assert tags | {-1} == plain_set | {-1}
+
+
+def test_init_that_fills_the_instance_is_not_filled_first():
+    seen = []
+
+    class Filling(NewType(list)):
+        def __init__(self, items=()) -> None:
+            seen.append(len(self))
+            list.__init__(self, items)
+
+    items = Filling(range(LARGE))
+    # the contents are not put in first, only for `__init__` to replace them
+    assert items + [1] == list(range(LARGE)) + [1]
+    assert seen == [0, 0]
@@ -0,0 +1,116 @@
+import gc
+import weakref
+
+import pytest
+
+from newtype import NewType
+
+
+class BoundedInt(NewType(int, params=("MAX_VALUE",))):
+    def __init__(self, value: int) -> None:
+        if value >= self.MAX_VALUE:
+            raise ValueError(f"{value} is not below {self.MAX_VALUE}")
+
+
+class Tagged(NewType(str, params=("PREFIX", "SUFFIX"))):
+    def __init__(self, value: str) -> None:
+        if not (value.startswith(self.PREFIX) and value.endswith(self.SUFFIX)):
+            raise ValueError(value)
+
+
+def test_instantiations_are_memoised():
+    assert BoundedInt[10] is BoundedInt[10]
+    assert BoundedInt[10] is not BoundedInt[20]
+    assert Tagged["<", ">"] is Tagged[("<", ">")]
+
+
+def test_instantiation_attributes():
+    cls = BoundedInt[10]
+    assert issubclass(cls, BoundedInt)
+    assert cls.MAX_VALUE == 10
+    assert cls.__qualname__ == "BoundedInt[10]"
+    assert cls.__module__ == BoundedInt.__module__
+    assert Tagged["<", ">"].__qualname__ == "Tagged['<', '>']"
+
+
+def test_parameters_validate_instances():
+    small = BoundedInt[10]
+    x = small(5)
+    assert type(x + 1) is small
+    with pytest.raises(ValueError, match="15 is not below 10"):
+        x * 3
+    assert type(BoundedInt[20](5) * 3) is BoundedInt[20]
+
+    cls = Tagged["<", ">"]
+    assert type(cls("<a>").upper()) is cls
+    with pytest.raises(ValueError):
+        cls("<a>").strip(">")
+
+
+def test_instantiations_share_method_descriptors():
+    for cls in (BoundedInt[1], BoundedInt[2]):
+        assert "__add__" not in vars(cls)
+        assert "__init__" not in vars(cls)
+        assert cls.__add__ is BoundedInt.__add__
+
+
+def test_same_params_share_generic_class():
+    assert NewType(int, params=("MAX_VALUE",)) is NewType(int, params=["MAX_VALUE"])
+    assert NewType(int, params="MAX_VALUE") is NewType(int, params=("MAX_VALUE",))
+    assert NewType(int, params=("MAX_VALUE",)) is not NewType(int, params=("LIMIT",))
+
+
+def test_invalid_params():
+    with pytest.raises(ValueError):
+        NewType(int, params=())
+    with pytest.raises(ValueError):
+        NewType(int, params=("not an identifier",))
+    with pytest.raises(ValueError):
+        NewType(int, params=("A", "A"))
+
+
+def test_wrong_number_of_arguments():
+    with pytest.raises(TypeError, match="takes 2 parameter"):
+        Tagged["<"]
+    with pytest.raises(TypeError, match="takes 1 parameter"):
+        BoundedInt[1, 2]
+
+
+def test_instantiations_cannot_be_parameterised_again():
+    with pytest.raises(TypeError, match="already parameterised"):
+        BoundedInt[10][20]
+
+
+def test_unhashable_arguments():
+    with pytest.raises(TypeError):
+        BoundedInt[[10]]
+
+
+def test_interned_instantiations_get_their_own_pool():
+    class Code(NewType(str, params=("LENGTH",)), intern=True):
+        def __init__(self, value: str) -> None:
+            if len(value) != self.LENGTH:
+                raise ValueError(value)
+
+    two, three = Code[2], Code[3]
+    assert two("ab") is two("ab")
+    assert three("abc") is three("abc")
+    assert two._newtype_pool_ is not three._newtype_pool_
+
+
+def test_unused_instantiations_are_collected():
+    refs = []
+    for i in range(100):
+        cls = BoundedInt[1000 + i]
+        assert cls(0) + 0 == 0
+        refs.append(weakref.ref(cls))
+    del cls
+    # the shared descriptors hold on to the class they were last bound to
+    assert BoundedInt[1](0) + 0 == 0
+    gc.collect()
+    assert all(ref() is None for ref in refs)
+    # the table drops dead entries as it grows
+    for i in range(200):
+        BoundedInt[2000 + i]
+    gc.collect()
+    assert len(BoundedInt._newtype_instances_) <= 256
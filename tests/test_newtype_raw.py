@@ -0,0 +1,96 @@
+import asyncio
+import threading
+
+import pytest
+from conftest import LEAK_LIMIT, limit_leaks
+
+import newtype
+from newtype import NewType
+
+
+class EmailStr(NewType(str)):
+    inits = 0
+
+    def __init__(self, val: str) -> None:
+        type(self).inits += 1
+        if "@" not in val:
+            raise ValueError(f"not an email: {val!r}")
+
+
+@limit_leaks(LEAK_LIMIT)
+def test_raw_returns_base_results():
+    email = EmailStr(" A@B.COM ")
+    EmailStr.inits = 0
+
+    with newtype.raw():
+        cleaned = email.strip().lower().replace("@", " at ")
+
+    assert type(cleaned) is str
+    assert cleaned == "a at b.com"
+    assert EmailStr.inits == 0
+    assert type(email.strip()) is EmailStr
+
+
+def test_rewrap():
+    email = EmailStr("a@b.com")
+    assert EmailStr.rewrap(email) is email
+
+    with newtype.raw():
+        cleaned = email.upper()
+    rewrapped = EmailStr.rewrap(cleaned)
+    assert type(rewrapped) is EmailStr
+    assert rewrapped == "A@B.COM"
+
+    with pytest.raises(ValueError, match="not an email"):
+        EmailStr.rewrap("nope")
+
+
+def test_raw_nests_and_resets_on_error():
+    email = EmailStr("a@b.com")
+    with pytest.raises(RuntimeError):
+        with newtype.raw():
+            with newtype.raw():
+                assert type(email.upper()) is str
+            assert type(email.upper()) is str
+            raise RuntimeError
+    assert type(email.upper()) is EmailStr
+
+
+def test_raw_is_per_thread():
+    email = EmailStr("a@b.com")
+    inside = threading.Event()
+    release = threading.Event()
+    results = []
+
+    def worker():
+        inside.wait()
+        results.append(type(email.upper()))
+        release.set()
+
+    thread = threading.Thread(target=worker)
+    thread.start()
+    with newtype.raw():
+        inside.set()
+        release.wait()
+        assert type(email.upper()) is str
+    thread.join()
+
+    assert results == [EmailStr]
+
+
+async def test_raw_is_per_task():
+    email = EmailStr("a@b.com")
+    entered = asyncio.Event()
+    leave = asyncio.Event()
+
+    async def in_raw():
+        with newtype.raw():
+            entered.set()
+            await leave.wait()
+            return type(email.upper())
+
+    task = asyncio.ensure_future(in_raw())
+    await entered.wait()
+    assert type(email.upper()) is EmailStr
+    leave.set()
+    assert await task is str
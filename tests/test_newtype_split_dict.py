@@ -0,0 +1,56 @@
+import sys
+
+import pytest
+
+from newtype import NewType
+
+
+class Point:
+    def __init__(self, x: int, y: int) -> None:
+        self.x = x
+        self.y = y
+        self.z = 0
+
+    def moved(self, dx: int) -> "Point":
+        return Point(self.x + dx, self.y)
+
+
+class Position(NewType(Point)):
+    def __init__(self, point: Point, frame: str = "world") -> None:
+        self.frame = frame
+
+
+class CustomNew(NewType(Point)):
+    def __new__(cls, *args, **kwargs):
+        return super().__new__(cls, *args, **kwargs)
+
+
+def shares_keys(obj) -> bool:
+    # a split dict reports the size of its values only, a combined copy of it also
+    # that of its keys
+    d = vars(obj)
+    return sys.getsizeof(d) < sys.getsizeof(dict(d))
+
+
+@pytest.mark.parametrize(
+    "make",
+    [
+        lambda: Position(Point(1, 2)),
+        lambda: Position(Point(1, 2), frame="local"),
+        lambda: Position.unsafe_cast(Point(1, 2)),
+        lambda: Position(Point(1, 2)).moved(1),
+        lambda: CustomNew(Point(1, 2)).moved(1),
+    ],
+    ids=["construct", "construct-kwargs", "unsafe_cast", "rewrap", "rewrap-custom-new"],
+)
+def test_instance_dicts_share_keys(make):
+    instances = [make() for _ in range(20)]
+    assert all(shares_keys(inst) for inst in instances[1:])
+
+
+def test_attribute_order_is_preserved():
+    inst = Position.unsafe_cast(Point(1, 2))
+    assert list(vars(inst))[:3] == ["x", "y", "z"]
+    moved = Position(Point(1, 2)).moved(3)
+    assert list(vars(moved))[:3] == ["x", "y", "z"]
+    assert (moved.x, moved.y, moved.frame) == (4, 2, "world")
@@ -0,0 +1,224 @@
+import gc
+import time
+import tracemalloc
+
+import pytest
+
+import newtype
+from newtype import NewType, newtype_invariant
+from newtype.extensions import newtypeinit, newtypemethod
+from newtype.newtype import latency_percentiles
+
+
+class Email(NewType(str)):
+    def __init__(self, val: str) -> None:
+        if "@" not in val:
+            raise ValueError(f"{val!r} is not an email address")
+
+
+class Trimmed(NewType(str)):
+    @newtype_invariant
+    def strip(self) -> "Trimmed":
+        return super().strip()
+
+
+class Point:
+    def __init__(self, x: int, y: int) -> None:
+        self.x = x
+        self.y = y
+
+    def moved(self, dx: int) -> "Point":
+        return Point(self.x + dx, self.y)
+
+
+class Located(NewType(Point)):
+    def __init__(self, val: Point) -> None:
+        self.label = "here"
+
+
+class Slow(NewType(str)):
+    def __init__(self, val: str) -> None:
+        if val == "slow":
+            time.sleep(0.005)
+
+
+@pytest.fixture
+def counting():
+    newtype.reset_stats()
+    previous = newtype.enable_stats()
+    yield
+    newtype.enable_stats(previous)
+    newtype.reset_stats()
+
+
+def test_stats_are_off_by_default():
+    newtype.reset_stats()
+    Email("a@b.c").upper()
+    assert Email.__newtype_stats__() == {}
+    assert newtype.stats() == {}
+
+
+def test_enable_stats_returns_the_previous_state(counting):
+    assert newtype.enable_stats(True) is True
+    assert newtype.enable_stats(False) is True
+    assert newtype.enable_stats(True) is False
+
+
+def test_enable_stats_sets_the_switch_of_each_module(counting):
+    # each extension module has its own switch
+    newtype.enable_stats(False)
+    assert newtypeinit.set_stats_enabled(True) is False
+    assert newtypemethod.set_stats_enabled(False) is False
+    newtype.enable_stats(True, latency=True)
+    assert newtypeinit.set_latency_enabled(True) is True
+    assert newtypemethod.set_latency_enabled(True) is True
+    assert newtypemethod.set_stats_enabled(True) is True
+
+
+def test_method_counters(counting):
+    email = Email("a@b.c")
+    email.upper()
+    email.startswith("a")
+    with pytest.raises(ValueError, match="is not an email address"):
+        email.replace("@", "")
+
+    counters = Email.__newtype_stats__()
+    assert counters["upper"]["calls"] == 1
+    assert counters["upper"]["rewraps"] == 1
+    assert counters["upper"]["validations"] == 1
+    assert counters["startswith"]["calls"] == 1
+    assert counters["startswith"]["rewraps"] == 0
+    assert counters["replace"]["validation_failures"] == 1
+    assert "lower" not in counters
+
+
+def test_init_counters(counting):
+    Email("a@b.c")
+    with pytest.raises(ValueError, match="is not an email address"):
+        Email("nobody")
+
+    counters = Email.__newtype_stats__()["__init__"]
+    assert counters["calls"] == 2
+    assert counters["validations"] == 2
+    assert counters["validation_failures"] == 1
+
+
+def test_invariant_methods_skip_validation(counting):
+    Trimmed(" x ").strip()
+
+    counters = Trimmed.__newtype_stats__()["strip"]
+    assert counters["rewraps"] == 1
+    assert counters["validations"] == 0
+
+
+def test_attributes_copied(counting):
+    Located(Point(1, 2)).moved(1)
+
+    counters = Located.__newtype_stats__()["moved"]
+    assert counters["rewraps"] == 1
+    assert counters["attributes_copied"] >= 1
+
+
+def test_stats_collects_every_used_newtype(counting):
+    Email("a@b.c").upper()
+
+    collected = newtype.stats()
+    assert set(collected) == {Email}
+    assert collected[Email] == Email.__newtype_stats__()
+
+
+def test_reset_stats(counting):
+    Email("a@b.c").upper()
+    Trimmed("x").upper()
+
+    newtype.reset_stats(Email)
+    assert Email.__newtype_stats__() == {}
+    assert Trimmed.__newtype_stats__() != {}
+
+    newtype.reset_stats()
+    assert newtype.stats() == {}
+
+
+def test_latency_is_only_recorded_on_request(counting):
+    Slow("x").upper()
+    assert Slow.__newtype_latency__() == {}
+    assert newtype.latency() == {}
+
+
+def test_latency_percentiles_show_the_tail(counting):
+    newtype.enable_stats(latency=True)
+    for i in range(999):
+        Slow(f"x{i}").upper()
+    Slow("slow")
+
+    percentiles = Slow.__newtype_latency__()
+    assert percentiles["rewrap"]["count"] == 999
+    assert percentiles["validation"]["count"] == 1999
+    assert percentiles["validation"]["p99"] < 5_000_000
+    assert percentiles["validation"]["max"] >= 5_000_000
+    assert newtype.latency() == {Slow: percentiles}
+
+    newtype.reset_stats(Slow)
+    assert Slow.__newtype_latency__() == {}
+
+
+def test_latency_percentiles():
+    buckets = [(10, 11, 50), (2048, 2100, 1), (1000, 1023, 49), (10, 11, 0)]
+    assert latency_percentiles(buckets) == {
+        "count": 100,
+        "p50": 11,
+        "p90": 1023,
+        "p99": 1023,
+        "p999": 2100,
+        "max": 2100,
+    }
+
+
+def test_latency_percentiles_merge_histograms():
+    # the top bucket of one histogram ends at its max, the same bucket of another
+    # spans its whole range
+    buckets = [(1000, 1010, 1), (1000, 1023, 9), (2048, 2100, 1), (2048, 2060, 1)]
+    summary = latency_percentiles(buckets)
+    assert summary["p50"] == 1023
+    assert summary["max"] == 2100
+
+
+def test_latency_max_is_exact(counting):
+    newtype.enable_stats(latency=True)
+    for i in range(100):
+        Slow(f"x{i}")
+    Slow("slow")
+
+    buckets = vars(Slow)["__init__"].latency()
+    lower, upper, _ = max(buckets)
+    assert upper >= 5_000_000
+    assert lower <= upper
+    assert upper == Slow.__newtype_latency__()["validation"]["max"]
+
+
+def test_histograms_are_freed_with_their_class(counting):
+    newtype.enable_stats(latency=True)
+
+    def make_and_drop() -> None:
+        class Temporary(NewType(str)):
+            def __init__(self, val: str) -> None:
+                pass
+
+            def shout(self) -> str:
+                return self.upper()
+
+        Temporary("x").shout()
+        del Temporary
+        gc.collect()
+
+    make_and_drop()  # fill the caches first
+    tracemalloc.start()
+    try:
+        before, _ = tracemalloc.get_traced_memory()
+        for _ in range(50):
+            make_and_drop()
+        after, _ = tracemalloc.get_traced_memory()
+    finally:
+        tracemalloc.stop()
+    # a histogram is over a kilobyte, two per class
+    assert after - before < 50 * 1024
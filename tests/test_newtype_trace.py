@@ -0,0 +1,131 @@
+import gc
+import threading
+
+import pytest
+
+import newtype
+from newtype import NewType
+from newtype.extensions import newtypeinit, newtypemethod
+
+
+class Email(NewType(str)):
+    def __init__(self, val: str) -> None:
+        if "@" not in val:
+            raise ValueError(f"{val!r} is not an email address")
+
+
+EMAIL = f"{Email.__module__}.{Email.__qualname__}"
+
+
+def events(lines):
+    return [line.split()[3] for line in lines]
+
+
+@pytest.fixture
+def tracing():
+    newtype.trace_dump(clear=True)
+    previous = newtype.enable_trace()
+    yield
+    newtype.enable_trace(previous)
+    newtype.trace_dump(clear=True)
+
+
+def test_trace_is_off_by_default():
+    newtype.trace_dump(clear=True)
+    Email("a@b.c").upper()
+    assert newtype.trace_dump() == []
+
+
+def test_trace_records_events_in_order(tracing):
+    email = Email("a@b.c")
+    email.upper()
+    with pytest.raises(ValueError, match="is not an email address"):
+        email.replace("@", "")
+    newtype.enable_trace(False)
+    email.lower()
+
+    lines = newtype.trace_dump()
+    assert events(lines) == [
+        "init_call",
+        "validate",
+        "method_call",
+        "init_call",
+        "validate",
+        "rewrap",
+        "method_call",
+        "init_call",
+        "validate_fail",
+        "rewrap_fail",
+    ]
+    assert all(line.endswith(EMAIL) for line in lines)
+
+
+def test_trace_dump_clear(tracing):
+    Email("a@b.c")
+    assert newtype.trace_dump(clear=True) != []
+    assert newtype.trace_dump() == []
+    Email("a@b.c")
+    assert events(newtype.trace_dump()) == ["init_call", "validate"]
+
+
+def test_trace_buffers_are_per_thread(tracing):
+    # alive together, so that no thread id is reused
+    barrier = threading.Barrier(4)
+
+    def work():
+        Email("a@b.c")
+        barrier.wait()
+
+    threads = [threading.Thread(target=work) for _ in range(4)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    lines = newtype.trace_dump()
+    assert len(lines) == 8
+    assert len({line.split()[2] for line in lines}) == 4
+
+
+def test_trace_buffers_keep_the_latest_events(tracing):
+    email = Email("a@b.c")
+    for _ in range(5000):
+        email.startswith("a")
+
+    records = newtypemethod.trace_records()
+    assert len(records) == 4096
+    assert [ns for _, ns, _, _ in records] == sorted(ns for _, ns, _, _ in records)
+
+
+def test_trace_names_types_that_are_gone(tracing):
+    class Temporary(NewType(int)):
+        pass
+
+    Temporary(1)
+    address = id(Temporary)
+    del Temporary
+    gc.collect()
+
+    lines = newtype.trace_dump()
+    assert lines
+    assert all(line.endswith(f"<type at {address:#x}>") for line in lines)
+
+
+def test_trace_buffers_of_exited_threads_are_handed_on(tracing):
+    # more threads than were ever given a buffer of their own before
+    idents = []
+
+    def work():
+        idents.append(threading.get_ident())
+        Email("a@b.c")
+
+    for _ in range(100):
+        thread = threading.Thread(target=work)
+        thread.start()
+        thread.join()
+
+    records = newtypeinit.trace_records()
+    assert idents[-1] in {thread for thread, _, _, _ in records}
+    # each thread took over the buffer of one that had exited, dropping its
+    # records, rather than keeping the 2 records of all 100 threads
+    assert len(records) < 20
@@ -0,0 +1,125 @@
+import os
+import subprocess
+import sys
+
+import pytest
+from conftest import LEAK_LIMIT, limit_leaks
+
+from newtype import NativeValidator, NewType
+from newtype.extensions import NEWTYPE_INIT_ARGS_STR, NEWTYPE_INIT_KWARGS_STR
+
+
+class UserId(NewType(str), validator=NativeValidator(max_len=4)):
+    inits = 0
+
+    def __init__(self, val: str) -> None:
+        type(self).inits += 1
+        if not val.startswith("u"):
+            raise ValueError("must start with 'u'")
+
+
+class Point:
+    def __init__(self, x: int, y: int) -> None:
+        self.x = x
+        self.y = y
+
+
+class Position(NewType(Point)):
+    def __init__(self, point: Point) -> None:
+        raise AssertionError("not called")
+
+
+class Slotted:
+    __slots__ = ("a",)
+
+    def __init__(self) -> None:
+        self.a = 1
+
+
+class SlottedNT(NewType(Slotted)):
+    pass
+
+
+@limit_leaks(LEAK_LIMIT)
+def test_unsafe_cast_skips_validation():
+    UserId.inits = 0
+    user_id = UserId.unsafe_cast("not-a-user-id")
+
+    assert type(user_id) is UserId
+    assert user_id == "not-a-user-id"
+    assert UserId.inits == 0
+    assert getattr(user_id, NEWTYPE_INIT_ARGS_STR) == ()
+    assert getattr(user_id, NEWTYPE_INIT_KWARGS_STR) == {}
+
+
+def test_unsafe_cast_result_rewraps():
+    user_id = UserId.unsafe_cast("u1")
+    assert type(user_id.lower()) is UserId
+    with pytest.raises(ValueError):
+        user_id.replace("u", "x")
+
+
+def test_unsafe_cast_same_type_is_identity():
+    user_id = UserId("u1")
+    assert UserId.unsafe_cast(user_id) is user_id
+
+
+@limit_leaks(LEAK_LIMIT)
+def test_unsafe_cast_object_base_copies_attributes():
+    point = Point(1, 2)
+    position = Position.unsafe_cast(point)
+
+    assert type(position) is Position
+    assert (position.x, position.y) == (1, 2)
+    position.x = 3
+    assert point.x == 1
+
+
+def test_unsafe_cast_object_base_with_slots():
+    value = SlottedNT.unsafe_cast(Slotted())
+    assert value.a == 1
+
+
+def test_unsafe_cast_custom_new_is_honoured():
+    class Upper(NewType(str)):
+        def __new__(cls, value: str, *args, **kwargs):
+            return super().__new__(cls, value.upper())
+
+    assert Upper.unsafe_cast("abc") == "ABC"
+
+
+def test_unsafe_cast_errors():
+    from newtype.extensions import unsafe_cast
+
+    with pytest.raises(TypeError, match="is not a NewType"):
+        unsafe_cast(str, 1)
+    with pytest.raises(TypeError, match="must be a type"):
+        unsafe_cast("a", "a")
+    with pytest.raises(TypeError):
+        unsafe_cast(UserId)
+
+
+@pytest.mark.parametrize(
+    ("flags", "env"),
+    [(["-X", "dev"], {}), ([], {"NEWTYPE_CHECK_UNSAFE_CAST": "1"})],
+)
+def test_unsafe_cast_check_mode(flags, env):
+    code = (
+        "from newtype import NewType\n"
+        "class Even(NewType(int)):\n"
+        "    def __init__(self, val):\n"
+        "        if val % 2:\n"
+        "            raise ValueError('odd')\n"
+        "assert Even.unsafe_cast(2) == 2\n"
+        "try:\n"
+        "    Even.unsafe_cast(3)\n"
+        "except ValueError:\n"
+        "    pass\n"
+        "else:\n"
+        "    raise SystemExit('not checked')\n"
+    )
+    subprocess.run(
+        [sys.executable, *flags, "-c", code],
+        check=True,
+        env={**os.environ, **env},
+    )
@@ -0,0 +1,172 @@
+import pickle
+
+import pytest
+from conftest import LEAK_LIMIT, limit_leaks
+
+from newtype import ExactKeyDict, NewType, unwrap, unwrap_many
+
+
+class UserId(NewType(str)):
+    pass
+
+
+class Count(NewType(int)):
+    pass
+
+
+class Ratio(NewType(float)):
+    pass
+
+
+class Blob(NewType(bytes)):
+    pass
+
+
+class Pair(NewType(tuple)):
+    pass
+
+
+class Tags(NewType(frozenset)):
+    pass
+
+
+class Point:
+    def __init__(self, x: int) -> None:
+        self.x = x
+
+
+class Position(NewType(Point)):
+    pass
+
+
+@pytest.mark.parametrize(
+    ("value", "base"),
+    [
+        (UserId("alice"), str),
+        (Count(3), int),
+        (Ratio(0.5), float),
+        (Blob(b"xy"), bytes),
+        (Pair((1, 2)), tuple),
+        (Tags({1, 2}), frozenset),
+    ],
+)
+@limit_leaks(LEAK_LIMIT)
+def test_unwrap_immutable_bases(value, base):
+    raw = unwrap(value)
+    assert type(raw) is base
+    assert raw == value
+
+
+def test_unwrap_exact_is_identity():
+    for value in ("a", 1, 1.0, b"a", (1,), frozenset(), True):
+        assert unwrap(value) is value
+
+
+def test_unwrap_copies_mutable_subclasses():
+    class MyList(list):
+        pass
+
+    mine = MyList([1, 2])
+    raw = unwrap(mine)
+    assert type(raw) is list
+    assert raw == [1, 2]
+    raw.append(3)
+    assert mine == [1, 2]
+
+    class MyDict(dict):
+        pass
+
+    assert type(unwrap(MyDict(a=1))) is dict
+
+
+def test_unwrap_object_base():
+    position = Position(Point(1))
+    raw = unwrap(position)
+    assert type(raw) is Point
+    assert raw.x == 1
+
+    other = object()
+    assert unwrap(other) is other
+
+
+class Celsius:
+    def __new__(cls, degrees: "float | Celsius") -> "Celsius":
+        self = super().__new__(cls)
+        self.degrees = float(getattr(degrees, "degrees", degrees))
+        return self
+
+
+class Temperature(NewType(Celsius)):
+    pass
+
+
+class Singleton:
+    def __new__(cls, value: object = None) -> "Singleton":
+        return value if isinstance(value, cls) else super().__new__(cls)
+
+
+class Unique(NewType(Singleton)):
+    pass
+
+
+def test_unwrap_custom_new_base():
+    temperature = Temperature(Celsius(21.5))
+    raw = unwrap(temperature)
+    assert type(raw) is Celsius
+    assert raw.degrees == 21.5
+    assert raw is not temperature
+
+    from decimal import Decimal
+
+    class Amount(NewType(Decimal)):
+        pass
+
+    raw = unwrap(Amount("1.50"))
+    assert type(raw) is Decimal
+    assert raw == Decimal("1.50")
+
+
+def test_unwrap_custom_new_base_errors():
+    with pytest.raises(TypeError, match="cannot unwrap `.*Unique`: `.*Singleton\\(value\\)`"):
+        unwrap(Unique(Singleton()))
+
+
+def test_unwrap_many():
+    values = [UserId("a"), "b", Count(1)]
+    raw = unwrap_many(values)
+    assert raw == ["a", "b", 1]
+    assert [type(v) for v in raw] == [str, str, int]
+    assert unwrap_many(iter([UserId("x")])) == ["x"]
+    with pytest.raises(TypeError):
+        unwrap_many(1)
+
+
+@limit_leaks(LEAK_LIMIT)
+def test_exact_key_dict_stores_exact_keys():
+    d = ExactKeyDict({UserId("a"): 1}, b=2)
+    d[UserId("c")] = 3
+    d.setdefault(UserId("d"), 4)
+    d.update([(UserId("e"), 5)])
+    d |= {UserId("f"): 6}
+
+    assert all(type(k) is str for k in d)
+    assert d == {"a": 1, "b": 2, "c": 3, "d": 4, "e": 5, "f": 6}
+    assert d[UserId("a")] == d["a"] == 1
+    assert UserId("c") in d
+    assert d.pop(UserId("f")) == 6
+
+
+def test_exact_key_dict_copies():
+    d = ExactKeyDict.fromkeys([UserId("a"), UserId("b")], 0)
+    assert type(d) is ExactKeyDict
+    assert all(type(k) is str for k in d)
+
+    merged = d | {UserId("c"): 1}
+    assert type(merged) is ExactKeyDict
+    assert all(type(k) is str for k in merged)
+    assert type(d.copy()) is ExactKeyDict
+
+    restored = pickle.loads(pickle.dumps(d))
+    assert type(restored) is ExactKeyDict
+    assert restored == d
+    assert repr(d) == "ExactKeyDict({'a': 0, 'b': 0})"